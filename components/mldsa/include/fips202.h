@@ -13,41 +13,52 @@
 #define PQC_SHAKEINCCTX_BYTES (sizeof(uint64_t)*26)
 #define PQC_SHAKECTX_BYTES (sizeof(uint64_t)*25)
 
+/* Contexts carry their Keccak state inline, so they live wherever the
+ * caller puts them (usually the stack) and never touch the heap. The
+ * _ctx_release functions are kept for API compatibility and do nothing. */
+
 // Context for incremental API
 typedef struct {
-    uint64_t *ctx;
+    uint64_t ctx[26];
 } shake128incctx;
 
 // Context for non-incremental API
 typedef struct {
-    uint64_t *ctx;
+    uint64_t ctx[25];
 } shake128ctx;
 
 // Context for incremental API
 typedef struct {
-    uint64_t *ctx;
+    uint64_t ctx[26];
 } shake256incctx;
 
 // Context for non-incremental API
 typedef struct {
-    uint64_t *ctx;
+    uint64_t ctx[25];
 } shake256ctx;
 
 // Context for incremental API
 typedef struct {
-    uint64_t *ctx;
+    uint64_t ctx[26];
 } sha3_256incctx;
 
 // Context for incremental API
 typedef struct {
-    uint64_t *ctx;
+    uint64_t ctx[26];
 } sha3_384incctx;
 
 // Context for incremental API
 typedef struct {
-    uint64_t *ctx;
+    uint64_t ctx[26];
 } sha3_512incctx;
 
+// Context for the 4-way API: four independent states advanced together.
+// The lane layout depends on the backend.
+typedef struct {
+    uint64_t s[4 * 25];
+    unsigned int active;
+} keccakx4_state;
+
 /* Initialize the state and absorb the provided input.
  *
  * This function does not support being called multiple times
@@ -126,7 +137,7 @@ void shake256(uint8_t *output, size_t outlen,
 void sha3_256_inc_init(sha3_256incctx *state);
 /* Absorb blocks into SHA3 */
 void sha3_256_inc_absorb(sha3_256incctx *state, const uint8_t *input, size_t inlen);
-/* Obtain the output of the function and free `state` */
+/* Obtain the output of the function */
 void sha3_256_inc_finalize(uint8_t *output, sha3_256incctx *state);
 /* Copy the context */
 void sha3_256_inc_ctx_clone(sha3_256incctx *dest, const sha3_256incctx *src);
@@ -139,7 +150,7 @@ void sha3_256(uint8_t *output, const uint8_t *input, size_t inlen);
 void sha3_384_inc_init(sha3_384incctx *state);
 /* Absorb blocks into SHA3 */
 void sha3_384_inc_absorb(sha3_384incctx *state, const uint8_t *input, size_t inlen);
-/* Obtain the output of the function and free `state` */
+/* Obtain the output of the function */
 void sha3_384_inc_finalize(uint8_t *output, sha3_384incctx *state);
 /* Copy the context */
 void sha3_384_inc_ctx_clone(sha3_384incctx *dest, const sha3_384incctx *src);
@@ -153,7 +164,7 @@ void sha3_384(uint8_t *output, const uint8_t *input, size_t inlen);
 void sha3_512_inc_init(sha3_512incctx *state);
 /* Absorb blocks into SHA3 */
 void sha3_512_inc_absorb(sha3_512incctx *state, const uint8_t *input, size_t inlen);
-/* Obtain the output of the function and free `state` */
+/* Obtain the output of the function */
 void sha3_512_inc_finalize(uint8_t *output, sha3_512incctx *state);
 /* Copy the context */
 void sha3_512_inc_ctx_clone(sha3_512incctx *dest, const sha3_512incctx *src);
@@ -163,4 +174,29 @@ void sha3_512_inc_ctx_release(sha3_512incctx *state);
 /* One-stop SHA3-512 shop */
 void sha3_512(uint8_t *output, const uint8_t *input, size_t inlen);
 
+/* Initialize four SHAKE128 states and absorb one input into each.
+ * All inputs have the same length; pass NULL for unused lanes. */
+void shake128x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0, const uint8_t *in1,
+                            const uint8_t *in2, const uint8_t *in3, size_t inlen);
+/* Squeeze nblocks from each lane. A NULL output drops that lane, which
+ * must not be squeezed again.
+ *
+ * Supports being called multiple times
+ */
+void shake128x4_squeezeblocks(uint8_t *out0, uint8_t *out1,
+                              uint8_t *out2, uint8_t *out3,
+                              size_t nblocks, keccakx4_state *state);
+
+/* 4-way SHAKE256, same conventions as the SHAKE128 variant */
+void shake256x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0, const uint8_t *in1,
+                            const uint8_t *in2, const uint8_t *in3, size_t inlen);
+void shake256x4_squeezeblocks(uint8_t *out0, uint8_t *out1,
+                              uint8_t *out2, uint8_t *out3,
+                              size_t nblocks, keccakx4_state *state);
+
+/* Known-answer self-test of the Keccak backend, returns 0 on success */
+int fips202_kat(void);
+
 #endif
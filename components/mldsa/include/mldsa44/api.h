@@ -0,0 +1,185 @@
+#ifndef PQCLEAN_MLDSA44_CLEAN_API_H
+#define PQCLEAN_MLDSA44_CLEAN_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES 1312
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_SECRETKEYBYTES 2560
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES 2420
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_ALGNAME "ML-DSA-44"
+
+/* Size of the scratch memory taken by the *_ws functions. One workspace
+ * serves keygen, signing and verification; it must be aligned for uint32_t
+ * and must not be shared between concurrent calls. */
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_WORKSPACEBYTES 50500
+
+/* Size of a secret key expanded by crypto_sign_expand_sk, and of the
+ * smaller workspace that signing from an expanded key needs. */
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_EXPANDEDSKBYTES 28804
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_ESK_WORKSPACEBYTES 21696
+
+/* Workspace for crypto_sign_signature_esk_spec: one signing workspace per
+ * speculative attempt. */
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_ESK_SPEC_WORKSPACEBYTES 43392
+
+/* Low-memory mode: a key expanded by crypto_sign_expand_sk_stream keeps no
+ * copy of the matrix A and regenerates it row by row while signing, with
+ * the same signing workspace. Verification in this mode takes the smaller
+ * workspace below. */
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_EXPANDEDSK_STREAMBYTES 12420
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_VERIFY_STREAM_WORKSPACEBYTES 22432
+
+/* Smallest signing key: crypto_sign_expand_sk_compact streams A as above
+ * and keeps the secret vectors in 8 and 16-bit coefficients. */
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_EXPANDEDSK_COMPACTBYTES 4228
+
+/* One entry of crypto_sign_presign, the message-independent half of a
+ * signing attempt, consumed by crypto_sign_signature_esk_pre. */
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_PRESIGBYTES 4160
+
+/* Workspace for crypto_sign_signature_batch, the same as for signing one
+ * message from an expanded key. */
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_BATCH_WORKSPACEBYTES 21696
+
+/* Public key expanded by crypto_sign_expand_pk for repeated verification,
+ * and the workspace of crypto_sign_verify_epk. */
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_EXPANDEDPKBYTES 20576
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_VERIFY_EPK_WORKSPACEBYTES 18336
+
+/* State of crypto_sign_init/update/final, which sign a message passed in
+ * pieces; aligned for uint64_t. */
+#define PQCLEAN_MLDSA44_CLEAN_CRYPTO_SIGN_STATEBYTES 208
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair_ws(uint8_t *pk, uint8_t *sk, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair(uint8_t *pk, uint8_t *sk);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_seed_keypair_ws(uint8_t *pk, uint8_t *sk, const uint8_t *seed, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_expand_sk(void *esk, const uint8_t *sk);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_expand_sk_stream(void *esk, const uint8_t *sk);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_expand_sk_compact(void *esk, const uint8_t *sk);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_init_ctx_esk(void *st, const uint8_t *ctx, size_t ctxlen, const void *esk);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_update(void *st, const uint8_t *m, size_t mlen);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_final_esk(uint8_t *sig, size_t *siglen, void *st, const void *esk, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_final_esk_spec(uint8_t *sig, size_t *siglen, void *st, const void *esk, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_final_esk_pre(uint8_t *sig, size_t *siglen, void *st, const void *esk,
+        void *pre, size_t *npre, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx_esk(uint8_t *sig, size_t *siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const void *esk, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx_esk_spec(uint8_t *sig, size_t *siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const void *esk, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_presign(void *pre, const void *esk, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx_esk_pre(uint8_t *sig, size_t *siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const void *esk, void *pre, size_t *npre, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx_batch(uint8_t *const sigs[], size_t siglens[],
+        const uint8_t *const msgs[], const size_t mlens[], size_t n,
+        const uint8_t *ctx, size_t ctxlen,
+        const void *esk, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx_ws(uint8_t *sig, size_t *siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *sk, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx(uint8_t *sig, size_t *siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *sk);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_ctx(uint8_t *sm, size_t *smlen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *sk);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx_ws(const uint8_t *sig, size_t siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *pk, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx_stream_ws(const uint8_t *sig, size_t siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *pk, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_expand_pk(void *epk, const uint8_t *pk);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx_epk(const uint8_t *sig, size_t siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const void *epk, void *ws);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx_batch(const uint8_t *const sigs[], const size_t siglens[],
+        const uint8_t *const msgs[], const size_t mlens[], size_t n,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *pk, uint8_t *ok);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx(const uint8_t *sig, size_t siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *pk);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_open_ctx(uint8_t *m, size_t *mlen,
+        const uint8_t *sm, size_t smlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *pk);
+
+/* Registers a fork-join hook so signing and matrix expansion can spread
+ * independent per-polynomial work over several cores; NULL switches back
+ * to single-task mode. par_for must run body(arg, i) for every i in
+ * [0, n) and return once all have finished. */
+void PQCLEAN_MLDSA44_CLEAN_crypto_sign_set_parallel(
+    void (*par_for)(void (*body)(void *arg, unsigned int i), void *arg, unsigned int n));
+
+/* Chooses the source of the per-signature randomness rnd: NULL draws it
+ * from randombytes (the default), crypto_sign_rnd_deterministic makes it
+ * zero for deterministic signatures, any other function (such as a DRBG)
+ * is called for RNDBYTES = 32 bytes per signature. */
+void PQCLEAN_MLDSA44_CLEAN_crypto_sign_set_rnd(void (*fill)(uint8_t *rnd, size_t len));
+
+void PQCLEAN_MLDSA44_CLEAN_crypto_sign_rnd_deterministic(uint8_t *rnd, size_t len);
+
+/* Known-answer self-test of seeded key generation and of deterministic
+ * and hedged signing, returns 0 on success */
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_kat(void);
+
+/* Known-answer self-test of the NTT backend, which all parameter sets
+ * share, returns 0 on success */
+int PQCLEAN_MLDSA_CLEAN_ntt_kat(void);
+#define PQCLEAN_MLDSA44_CLEAN_ntt_kat PQCLEAN_MLDSA_CLEAN_ntt_kat
+
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature(sig, siglen, m, mlen, sk) PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx(sig, siglen, m, mlen, NULL, 0, sk)
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign(sm, smlen, m, mlen, sk) PQCLEAN_MLDSA44_CLEAN_crypto_sign_ctx(sm, smlen, m, mlen, NULL, 0, sk)
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify(sig, siglen, m, mlen, pk) PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx(sig, siglen, m, mlen, NULL, 0, pk)
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign_open(m, mlen, sm, smlen, pk) PQCLEAN_MLDSA44_CLEAN_crypto_sign_open_ctx(m, mlen, sm, smlen, NULL, 0, pk)
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign_init_esk(st, esk) PQCLEAN_MLDSA44_CLEAN_crypto_sign_init_ctx_esk(st, NULL, 0, esk)
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_esk(sig, siglen, m, mlen, esk, ws) PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx_esk(sig, siglen, m, mlen, NULL, 0, esk, ws)
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_esk_spec(sig, siglen, m, mlen, esk, ws) PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx_esk_spec(sig, siglen, m, mlen, NULL, 0, esk, ws)
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_esk_pre(sig, siglen, m, mlen, esk, pre, npre, ws) PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx_esk_pre(sig, siglen, m, mlen, NULL, 0, esk, pre, npre, ws)
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_batch(sigs, siglens, msgs, mlens, n, esk, ws) PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx_batch(sigs, siglens, msgs, mlens, n, NULL, 0, esk, ws)
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ws(sig, siglen, m, mlen, sk, ws) PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx_ws(sig, siglen, m, mlen, NULL, 0, sk, ws)
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ws(sig, siglen, m, mlen, pk, ws) PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx_ws(sig, siglen, m, mlen, NULL, 0, pk, ws)
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_stream_ws(sig, siglen, m, mlen, pk, ws) PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx_stream_ws(sig, siglen, m, mlen, NULL, 0, pk, ws)
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_epk(sig, siglen, m, mlen, epk, ws) PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx_epk(sig, siglen, m, mlen, NULL, 0, epk, ws)
+#define PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_batch(sigs, siglens, msgs, mlens, n, pk, ok) PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx_batch(sigs, siglens, msgs, mlens, n, NULL, 0, pk, ok)
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef PQCLEAN_MLDSA_CLEAN_NTT_H
+#define PQCLEAN_MLDSA_CLEAN_NTT_H
+#include "params.h"
+#include <stdint.h>
+
+void PQCLEAN_MLDSA_CLEAN_ntt(int32_t a[N]);
+
+void PQCLEAN_MLDSA_CLEAN_invntt_tomont(int32_t a[N]);
+
+int PQCLEAN_MLDSA_CLEAN_ntt_kat(void);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef PQCLEAN_MLDSA_CLEAN_PARALLEL_H
+#define PQCLEAN_MLDSA_CLEAN_PARALLEL_H
+#include "params.h"
+
+/* Optional fork-join hook for spreading independent per-polynomial work
+ * over several cores. The scheme itself stays free of any RTOS code: the
+ * application registers a par_for that runs body(arg, i) for every i in
+ * [0, n) and returns once all calls have finished. Without a hook, or
+ * with NULL, everything runs on the calling task. */
+typedef void (*MLDSA_NAMESPACE(par_body))(void *arg, unsigned int i);
+typedef void (*MLDSA_NAMESPACE(par_for_fn))(MLDSA_NAMESPACE(par_body) body,
+        void *arg, unsigned int n);
+
+void MLDSA_NAMESPACE(crypto_sign_set_parallel)(MLDSA_NAMESPACE(par_for_fn) par_for);
+
+int MLDSA_NAMESPACE(par_enabled)(void);
+
+void MLDSA_NAMESPACE(par_for)(MLDSA_NAMESPACE(par_body) body, void *arg, unsigned int n);
+
+#endif
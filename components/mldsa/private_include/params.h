@@ -0,0 +1,151 @@
+#ifndef PQCLEAN_MLDSA_CLEAN_PARAMS_H
+#define PQCLEAN_MLDSA_CLEAN_PARAMS_H
+
+
+
+#define SEEDBYTES 32
+#define CRHBYTES 64
+#define TRBYTES 64
+#define RNDBYTES 32
+#define N 256
+#define Q 8380417
+#define D 13
+#define ROOT_OF_UNITY 1753
+
+#define POLYT1_PACKEDBYTES  320
+#define POLYT0_PACKEDBYTES  416
+
+/* The sources in src/level are compiled once per parameter set, by
+ * mldsa44.c, mldsa65.c and mldsa87.c with MLDSA_LEVEL defined; everything
+ * else is shared between the sets and only sees the constants above. */
+#ifdef MLDSA_LEVEL
+
+#if MLDSA_LEVEL == 44
+#define MLDSA_NAMESPACE(s) PQCLEAN_MLDSA44_CLEAN_##s
+#define MLDSA_API_H "mldsa44/api.h"
+#define K 4
+#define L 4
+#define ETA 2
+#define TAU 39
+#define BETA 78
+#define GAMMA1 (1 << 17)
+#define GAMMA2 ((Q-1)/88)
+#define OMEGA 80
+#define CTILDEBYTES 32
+
+#elif MLDSA_LEVEL == 65
+#define MLDSA_NAMESPACE(s) PQCLEAN_MLDSA65_CLEAN_##s
+#define MLDSA_API_H "mldsa65/api.h"
+#define K 6
+#define L 5
+#define ETA 4
+#define TAU 49
+#define BETA 196
+#define GAMMA1 (1 << 19)
+#define GAMMA2 ((Q-1)/32)
+#define OMEGA 55
+#define CTILDEBYTES 48
+
+#elif MLDSA_LEVEL == 87
+#define MLDSA_NAMESPACE(s) PQCLEAN_MLDSA87_CLEAN_##s
+#define MLDSA_API_H "mldsa87/api.h"
+#define K 8
+#define L 7
+#define ETA 2
+#define TAU 60
+#define BETA 120
+#define GAMMA1 (1 << 19)
+#define GAMMA2 ((Q-1)/32)
+#define OMEGA 75
+#define CTILDEBYTES 64
+
+#else
+#error "MLDSA_LEVEL must be 44, 65 or 87"
+#endif
+
+
+#define POLYVECH_PACKEDBYTES (OMEGA + K)
+
+#if GAMMA1 == (1 << 17)
+#define POLYZ_PACKEDBYTES   576
+#elif GAMMA1 == (1 << 19)
+#define POLYZ_PACKEDBYTES   640
+#endif
+
+#if GAMMA2 == (Q-1)/88
+#define POLYW1_PACKEDBYTES  192
+#elif GAMMA2 == (Q-1)/32
+#define POLYW1_PACKEDBYTES  128
+#endif
+
+#if ETA == 2
+#define POLYETA_PACKEDBYTES  96
+#elif ETA == 4
+#define POLYETA_PACKEDBYTES 128
+#endif
+
+/* Challenge products c*s1, c*s2 and c*t0 of the full and streaming key
+ * forms: 1 multiplies by the TAU nonzero coefficients of c directly, 0 goes
+ * through the NTT. Per polynomial that is TAU*N additions against one
+ * pointwise product and inverse NTT; the NTT wins on a scalar core for
+ * the TAU of every set. Compact keys always take the sparse path. */
+#ifndef PQC_MLDSA44_SPARSE_CHALLENGE
+#define PQC_MLDSA44_SPARSE_CHALLENGE 0
+#endif
+#ifndef PQC_MLDSA65_SPARSE_CHALLENGE
+#define PQC_MLDSA65_SPARSE_CHALLENGE 0
+#endif
+#ifndef PQC_MLDSA87_SPARSE_CHALLENGE
+#define PQC_MLDSA87_SPARSE_CHALLENGE 0
+#endif
+
+/* SIGN_KAT_*: first 16 bytes of SHAKE256 of the deterministic and of the
+ * hedged signature made by crypto_sign_kat */
+#if MLDSA_LEVEL == 44
+#define SPARSE_CHALLENGE PQC_MLDSA44_SPARSE_CHALLENGE
+#define SIGN_KAT_DETERMINISTIC \
+    {0x90, 0x58, 0x88, 0xe5, 0x16, 0x9c, 0xd2, 0x90, 0xad, 0xbf, 0x00, 0x7e, 0xe3, 0xd1, 0x43, 0x90}
+#define SIGN_KAT_HEDGED \
+    {0x11, 0xba, 0xb5, 0xc4, 0xf5, 0xe7, 0x65, 0xb6, 0x9f, 0x1b, 0x77, 0x92, 0x4d, 0x97, 0xe9, 0x5b}
+#elif MLDSA_LEVEL == 65
+#define SPARSE_CHALLENGE PQC_MLDSA65_SPARSE_CHALLENGE
+#define SIGN_KAT_DETERMINISTIC \
+    {0x15, 0x37, 0x5f, 0x84, 0xc3, 0xb5, 0xb9, 0x42, 0x96, 0xf0, 0xe4, 0xc1, 0x93, 0x4a, 0x02, 0x42}
+#define SIGN_KAT_HEDGED \
+    {0xc0, 0x71, 0x03, 0xcf, 0xb5, 0x71, 0x42, 0xca, 0x3f, 0x59, 0x46, 0x05, 0x44, 0x17, 0x82, 0xaa}
+#else
+#define SPARSE_CHALLENGE PQC_MLDSA87_SPARSE_CHALLENGE
+#define SIGN_KAT_DETERMINISTIC \
+    {0x47, 0xe8, 0x6c, 0xa2, 0x40, 0x36, 0xcc, 0xcb, 0xc3, 0x9f, 0x75, 0x6c, 0x32, 0x69, 0x17, 0xf4}
+#define SIGN_KAT_HEDGED \
+    {0x40, 0xe5, 0x4c, 0x9b, 0xa4, 0x1e, 0x40, 0xef, 0xf2, 0x81, 0x2c, 0x88, 0x22, 0x92, 0xac, 0xa2}
+#endif
+
+#define CRYPTO_PUBLICKEYBYTES (SEEDBYTES + K*POLYT1_PACKEDBYTES)
+#define CRYPTO_SECRETKEYBYTES (2*SEEDBYTES \
+        + TRBYTES \
+        + L*POLYETA_PACKEDBYTES \
+        + K*POLYETA_PACKEDBYTES \
+        + K*POLYT0_PACKEDBYTES)
+#define CRYPTO_BYTES (CTILDEBYTES + L*POLYZ_PACKEDBYTES + POLYVECH_PACKEDBYTES)
+#define CRYPTO_EXPANDEDSK_STREAMBYTES ((L + 2*K)*N*4 + 2*SEEDBYTES + TRBYTES + 4)
+#define CRYPTO_EXPANDEDSK_COMPACTBYTES ((L + 3*K)*N + 2*SEEDBYTES + TRBYTES + 4)
+#define CRYPTO_EXPANDEDSKBYTES (CRYPTO_EXPANDEDSK_STREAMBYTES \
+        + K*L*N*4)
+#define CRYPTO_ESK_WORKSPACEBYTES ((2*L + 3*K + 1)*N*4 \
+        + SEEDBYTES + RNDBYTES + 2*CRHBYTES)
+#define CRYPTO_ESK_SPEC_WORKSPACEBYTES (2*CRYPTO_ESK_WORKSPACEBYTES)
+#define CRYPTO_WORKSPACEBYTES (CRYPTO_EXPANDEDSKBYTES \
+        + CRYPTO_ESK_WORKSPACEBYTES)
+#define CRYPTO_BATCH_WORKSPACEBYTES CRYPTO_ESK_WORKSPACEBYTES
+#define CRYPTO_SIGN_STATEBYTES (26*8)
+#define CRYPTO_PRESIGBYTES (CRHBYTES + K*N*4)
+#define CRYPTO_VERIFY_STREAM_WORKSPACEBYTES ((2*L + 3*K + 1)*N*4 \
+        + K*POLYW1_PACKEDBYTES + SEEDBYTES + CRHBYTES + 2*CTILDEBYTES)
+#define CRYPTO_EXPANDEDPKBYTES (SEEDBYTES + TRBYTES + (K + K*L)*N*4)
+#define CRYPTO_VERIFY_EPK_WORKSPACEBYTES ((L + 3*K + 1)*N*4 \
+        + K*POLYW1_PACKEDBYTES + SEEDBYTES + CRHBYTES + 2*CTILDEBYTES)
+
+#endif /* MLDSA_LEVEL */
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef PQCLEAN_MLDSA_CLEAN_POLY_H
+#define PQCLEAN_MLDSA_CLEAN_POLY_H
+#include "params.h"
+#include <stdint.h>
+
+typedef struct {
+    int32_t coeffs[N];
+} poly;
+
+/* Compact storage for operands with small coefficients: s1 and s2 lie in
+ * [-ETA, ETA] and t0 in (-2^{D-1}, 2^{D-1}] */
+typedef struct {
+    int8_t coeffs[N];
+} poly_s8;
+
+typedef struct {
+    int16_t coeffs[N];
+} poly_s16;
+
+void PQCLEAN_MLDSA_CLEAN_poly_reduce(poly *a);
+void PQCLEAN_MLDSA_CLEAN_poly_caddq(poly *a);
+
+void PQCLEAN_MLDSA_CLEAN_poly_add(poly *c, const poly *a, const poly *b);
+void PQCLEAN_MLDSA_CLEAN_poly_sub(poly *c, const poly *a, const poly *b);
+void PQCLEAN_MLDSA_CLEAN_poly_shiftl(poly *a);
+
+void PQCLEAN_MLDSA_CLEAN_poly_ntt(poly *a);
+void PQCLEAN_MLDSA_CLEAN_poly_invntt_tomont(poly *a);
+void PQCLEAN_MLDSA_CLEAN_poly_pointwise_montgomery(poly *c, const poly *a, const poly *b);
+
+int PQCLEAN_MLDSA_CLEAN_poly_chknorm(const poly *a, int32_t B);
+void PQCLEAN_MLDSA_CLEAN_poly_uniform(poly *a,
+                                      const uint8_t seed[SEEDBYTES],
+                                      uint16_t nonce);
+void PQCLEAN_MLDSA_CLEAN_poly_uniform_4x(poly *a0, poly *a1, poly *a2, poly *a3,
+        const uint8_t seed[SEEDBYTES],
+        uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3);
+void PQCLEAN_MLDSA_CLEAN_poly_to_s8(poly_s8 *r, const poly *a);
+void PQCLEAN_MLDSA_CLEAN_poly_to_s16(poly_s16 *r, const poly *a);
+
+void PQCLEAN_MLDSA_CLEAN_polyt1_pack(uint8_t *r, const poly *a);
+void PQCLEAN_MLDSA_CLEAN_polyt1_unpack(poly *r, const uint8_t *a);
+
+void PQCLEAN_MLDSA_CLEAN_polyt0_pack(uint8_t *r, const poly *a);
+void PQCLEAN_MLDSA_CLEAN_polyt0_unpack(poly *r, const uint8_t *a);
+
+/* Everything below depends on the parameter set */
+#ifdef MLDSA_LEVEL
+
+/* Challenge c as its TAU nonzero positions and the coefficient,
+ * 1 or -1, at each of them */
+typedef struct {
+    uint8_t pos[TAU];
+    int8_t sign[TAU];
+} poly_sparse;
+
+void MLDSA_NAMESPACE(poly_power2round)(poly *a1, poly *a0, const poly *a);
+void MLDSA_NAMESPACE(poly_decompose)(poly *a1, poly *a0, const poly *a);
+unsigned int MLDSA_NAMESPACE(poly_make_hint)(poly *h, const poly *a0, const poly *a1);
+void MLDSA_NAMESPACE(poly_use_hint)(poly *b, const poly *a, const poly *h);
+
+void MLDSA_NAMESPACE(poly_uniform_eta)(poly *a,
+        const uint8_t seed[CRHBYTES],
+        uint16_t nonce);
+void MLDSA_NAMESPACE(poly_uniform_gamma1)(poly *a,
+        const uint8_t seed[CRHBYTES],
+        uint16_t nonce);
+void MLDSA_NAMESPACE(poly_uniform_eta_4x)(poly *a0, poly *a1, poly *a2, poly *a3,
+        const uint8_t seed[CRHBYTES],
+        uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3);
+void MLDSA_NAMESPACE(poly_uniform_gamma1_4x)(poly *a0, poly *a1, poly *a2, poly *a3,
+        const uint8_t seed[CRHBYTES],
+        uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3);
+void MLDSA_NAMESPACE(poly_challenge)(poly *c, const uint8_t seed[CTILDEBYTES]);
+void MLDSA_NAMESPACE(poly_challenge_sparse)(poly_sparse *c, const uint8_t seed[CTILDEBYTES]);
+
+void MLDSA_NAMESPACE(poly_sparse_mul)(poly *r, const poly_sparse *c, const poly *a);
+void MLDSA_NAMESPACE(poly_sparse_mul_s8)(poly *r, const poly_sparse *c, const poly_s8 *a);
+void MLDSA_NAMESPACE(poly_sparse_mul_s16)(poly *r, const poly_sparse *c, const poly_s16 *a);
+
+void MLDSA_NAMESPACE(polyeta_pack)(uint8_t *r, const poly *a);
+void MLDSA_NAMESPACE(polyeta_unpack)(poly *r, const uint8_t *a);
+
+void MLDSA_NAMESPACE(polyz_pack)(uint8_t *r, const poly *a);
+void MLDSA_NAMESPACE(polyz_unpack)(poly *r, const uint8_t *a);
+
+void MLDSA_NAMESPACE(polyw1_pack)(uint8_t *r, const poly *a);
+#endif
+
+#endif
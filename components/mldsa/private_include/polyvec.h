@@ -0,0 +1,86 @@
+#ifndef PQCLEAN_MLDSA_CLEAN_POLYVEC_H
+#define PQCLEAN_MLDSA_CLEAN_POLYVEC_H
+#include "params.h"
+#include "poly.h"
+#include <stdint.h>
+
+/* Vectors of polynomials of length L */
+typedef struct {
+    poly vec[L];
+} polyvecl;
+
+/* Compact vector for the secret s1 */
+typedef struct {
+    poly_s8 vec[L];
+} polyvecl_s8;
+
+void MLDSA_NAMESPACE(polyvecl_uniform_eta)(polyvecl *v, const uint8_t seed[CRHBYTES], uint16_t nonce);
+
+void MLDSA_NAMESPACE(polyvecl_uniform_gamma1)(polyvecl *v, const uint8_t seed[CRHBYTES], uint16_t nonce);
+
+void MLDSA_NAMESPACE(polyvecl_reduce)(polyvecl *v);
+
+void MLDSA_NAMESPACE(polyvecl_add)(polyvecl *w, const polyvecl *u, const polyvecl *v);
+
+void MLDSA_NAMESPACE(polyvecl_ntt)(polyvecl *v);
+void MLDSA_NAMESPACE(polyvecl_invntt_tomont)(polyvecl *v);
+void MLDSA_NAMESPACE(polyvecl_pointwise_poly_montgomery)(polyvecl *r, const poly *a, const polyvecl *v);
+void MLDSA_NAMESPACE(polyvecl_pointwise_acc_montgomery)(poly *w,
+        const polyvecl *u,
+        const polyvecl *v);
+
+
+int MLDSA_NAMESPACE(polyvecl_chknorm)(const polyvecl *v, int32_t B);
+
+
+
+/* Vectors of polynomials of length K */
+typedef struct {
+    poly vec[K];
+} polyveck;
+
+/* Compact vectors for the secrets s2 and t0 */
+typedef struct {
+    poly_s8 vec[K];
+} polyveck_s8;
+
+typedef struct {
+    poly_s16 vec[K];
+} polyveck_s16;
+
+void MLDSA_NAMESPACE(polyveck_uniform_eta)(polyveck *v, const uint8_t seed[CRHBYTES], uint16_t nonce);
+
+void MLDSA_NAMESPACE(polyveck_reduce)(polyveck *v);
+void MLDSA_NAMESPACE(polyveck_caddq)(polyveck *v);
+
+void MLDSA_NAMESPACE(polyveck_add)(polyveck *w, const polyveck *u, const polyveck *v);
+void MLDSA_NAMESPACE(polyveck_sub)(polyveck *w, const polyveck *u, const polyveck *v);
+void MLDSA_NAMESPACE(polyveck_shiftl)(polyveck *v);
+
+void MLDSA_NAMESPACE(polyveck_ntt)(polyveck *v);
+void MLDSA_NAMESPACE(polyveck_invntt_tomont)(polyveck *v);
+void MLDSA_NAMESPACE(polyveck_pointwise_poly_montgomery)(polyveck *r, const poly *a, const polyveck *v);
+
+int MLDSA_NAMESPACE(polyveck_chknorm)(const polyveck *v, int32_t B);
+
+void MLDSA_NAMESPACE(polyveck_power2round)(polyveck *v1, polyveck *v0, const polyveck *v);
+void MLDSA_NAMESPACE(polyveck_decompose)(polyveck *v1, polyveck *v0, const polyveck *v);
+unsigned int MLDSA_NAMESPACE(polyveck_make_hint)(polyveck *h,
+        const polyveck *v0,
+        const polyveck *v1);
+void MLDSA_NAMESPACE(polyveck_use_hint)(polyveck *w, const polyveck *v, const polyveck *h);
+
+void MLDSA_NAMESPACE(polyveck_pack_w1)(uint8_t r[K * POLYW1_PACKEDBYTES], const polyveck *w1);
+
+void MLDSA_NAMESPACE(polyvec_matrix_expand)(polyvecl mat[K], const uint8_t rho[SEEDBYTES]);
+
+void MLDSA_NAMESPACE(polyvec_matrix_expand_row)(polyvecl *row, const uint8_t rho[SEEDBYTES], unsigned int i);
+
+void MLDSA_NAMESPACE(polyvec_matrix_pointwise_montgomery)(polyveck *t, const polyvecl mat[K], const polyvecl *v);
+
+void MLDSA_NAMESPACE(polyvec_matrix_pointwise_invntt_tomont)(polyveck *t, const polyvecl mat[K], const polyvecl *v);
+
+void MLDSA_NAMESPACE(polyvec_matrix_stream_pointwise_montgomery)(polyveck *t, polyvecl *row,
+        const uint8_t rho[SEEDBYTES], const polyvecl *v);
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef PQCLEAN_MLDSA_CLEAN_SIGN_H
+#define PQCLEAN_MLDSA_CLEAN_SIGN_H
+#include "params.h"
+#include "poly.h"
+#include "polyvec.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Leading fields of every expanded key form */
+typedef struct {
+    uint8_t rho[SEEDBYTES];
+    uint8_t tr[TRBYTES];
+    uint8_t key[SEEDBYTES];
+    uint32_t form;
+} MLDSA_NAMESPACE(esk_header);
+
+/* Values of esk_header.form */
+#define ESK_FORM_STREAM  0
+#define ESK_FORM_FULL    1
+#define ESK_FORM_COMPACT 2
+
+/* Secret key expanded for signing without the matrix A, which is
+ * regenerated from rho row by row instead (streaming form). The secret
+ * vectors are in NTT domain, or plain if SPARSE_CHALLENGE is set. */
+typedef struct {
+    MLDSA_NAMESPACE(esk_header) hd;
+    polyvecl s1;
+    polyveck s2;
+    polyveck t0;
+} MLDSA_NAMESPACE(expanded_sk_stream);
+
+/* Secret key expanded for signing; A is in NTT domain.
+ * Starts with the streaming form, so either can be passed to the signer. */
+typedef struct {
+    MLDSA_NAMESPACE(expanded_sk_stream) k;
+    polyvecl mat[K];
+} MLDSA_NAMESPACE(expanded_sk);
+
+/* Smallest expanded form: A is streamed as above and the secrets keep
+ * their small coefficients in 8 and 16 bits, multiplied by the challenge
+ * directly instead of through the NTT. */
+typedef struct {
+    MLDSA_NAMESPACE(esk_header) hd;
+    polyvecl_s8 s1;
+    polyveck_s8 s2;
+    polyveck_s16 t0;
+} MLDSA_NAMESPACE(expanded_sk_compact);
+
+/* Per-signature state of the rejection loop. With a streamed matrix, each
+ * row of A is regenerated into row, which is free while w = A*z is formed.
+ * The sparse challenge path takes c as csp instead of NTT(c) in cp. */
+typedef struct {
+    uint8_t seedbuf[SEEDBYTES + RNDBYTES + 2 * CRHBYTES];
+    polyvecl y, z;
+    polyveck w1, w0;
+    union {
+        polyveck h;
+        polyvecl row;
+    };
+    union {
+        poly cp;
+        poly_sparse csp;
+    };
+} MLDSA_NAMESPACE(sign_scratch);
+
+/* Commitment precomputed for a later signature: the seed of the mask y
+ * and w = A*y, coefficients in [0, Q). Secret, and used at most once. */
+typedef struct {
+    uint8_t rhoprime[CRHBYTES];
+    polyveck w;
+} MLDSA_NAMESPACE(presig);
+
+/* Verification state apart from the matrix */
+typedef struct {
+    uint8_t buf[K * POLYW1_PACKEDBYTES];
+    uint8_t rho[SEEDBYTES];
+    uint8_t mu[CRHBYTES];
+    uint8_t c[CTILDEBYTES];
+    uint8_t c2[CTILDEBYTES];
+    poly cp;
+    polyvecl z;
+    polyveck t1, w1, h;
+} MLDSA_NAMESPACE(verify_scratch);
+
+/* Public key expanded for repeated verification: A in NTT domain and
+ * t1*2^d in NTT domain, with tr = H(pk) */
+typedef struct {
+    uint8_t rho[SEEDBYTES];
+    uint8_t tr[TRBYTES];
+    polyveck t1;
+    polyvecl mat[K];
+} MLDSA_NAMESPACE(expanded_pk);
+
+/* Single allocation behind crypto_sign_verify_batch */
+typedef struct {
+    MLDSA_NAMESPACE(expanded_pk) epk;
+    MLDSA_NAMESPACE(verify_scratch) v;
+} MLDSA_NAMESPACE(verify_batch_workspace);
+
+/* Scratch memory for verification with a streamed matrix */
+typedef struct {
+    MLDSA_NAMESPACE(verify_scratch) v;
+    polyvecl row;
+} MLDSA_NAMESPACE(verify_stream_workspace);
+
+/* Scratch memory for keygen, signing and verification. The three
+ * operations never run concurrently on one workspace, so they share it. */
+typedef union {
+    struct {
+        uint8_t seedbuf[2 * SEEDBYTES + CRHBYTES];
+        uint8_t tr[TRBYTES];
+        polyvecl mat[K];
+        polyvecl s1, s1hat;
+        polyveck s2, t1, t0;
+    } keypair;
+    struct {
+        MLDSA_NAMESPACE(expanded_sk) esk;
+        MLDSA_NAMESPACE(sign_scratch) scratch;
+    } sign;
+    struct {
+        MLDSA_NAMESPACE(verify_scratch) v;
+        polyvecl mat[K];
+    } verify;
+} MLDSA_NAMESPACE(workspace);
+
+int MLDSA_NAMESPACE(crypto_sign_keypair_ws)(uint8_t *pk, uint8_t *sk, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_keypair)(uint8_t *pk, uint8_t *sk);
+
+int MLDSA_NAMESPACE(crypto_sign_seed_keypair_ws)(uint8_t *pk, uint8_t *sk, const uint8_t *seed, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_expand_sk)(void *esk, const uint8_t *sk);
+
+int MLDSA_NAMESPACE(crypto_sign_expand_sk_stream)(void *esk, const uint8_t *sk);
+
+int MLDSA_NAMESPACE(crypto_sign_expand_sk_compact)(void *esk, const uint8_t *sk);
+
+int MLDSA_NAMESPACE(crypto_sign_init_ctx_esk)(void *st, const uint8_t *ctx, size_t ctxlen, const void *esk);
+
+int MLDSA_NAMESPACE(crypto_sign_update)(void *st, const uint8_t *m, size_t mlen);
+
+int MLDSA_NAMESPACE(crypto_sign_final_esk)(uint8_t *sig, size_t *siglen, void *st, const void *esk, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_final_esk_spec)(uint8_t *sig, size_t *siglen, void *st, const void *esk, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_final_esk_pre)(uint8_t *sig, size_t *siglen, void *st, const void *esk,
+        void *pre, size_t *npre, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_signature_ctx_esk)(uint8_t *sig, size_t *siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const void *esk, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_signature_ctx_esk_spec)(uint8_t *sig, size_t *siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const void *esk, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_presign)(void *pre, const void *esk, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_signature_ctx_esk_pre)(uint8_t *sig, size_t *siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const void *esk, void *pre, size_t *npre, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_signature_ctx_batch)(uint8_t *const sigs[], size_t siglens[],
+        const uint8_t *const msgs[], const size_t mlens[], size_t n,
+        const uint8_t *ctx, size_t ctxlen,
+        const void *esk, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_signature_ctx_ws)(uint8_t *sig, size_t *siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *sk, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_signature_ctx)(uint8_t *sig, size_t *siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *sk);
+
+int MLDSA_NAMESPACE(crypto_sign_ctx)(uint8_t *sm, size_t *smlen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *sk);
+
+void MLDSA_NAMESPACE(crypto_sign_set_rnd)(void (*fill)(uint8_t *rnd, size_t len));
+
+void MLDSA_NAMESPACE(crypto_sign_rnd_deterministic)(uint8_t *rnd, size_t len);
+
+int MLDSA_NAMESPACE(crypto_sign_kat)(void);
+
+int MLDSA_NAMESPACE(crypto_sign_verify_ctx_ws)(const uint8_t *sig, size_t siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *pk, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_verify_ctx_stream_ws)(const uint8_t *sig, size_t siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *pk, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_expand_pk)(void *epk, const uint8_t *pk);
+
+int MLDSA_NAMESPACE(crypto_sign_verify_ctx_epk)(const uint8_t *sig, size_t siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const void *epk, void *ws);
+
+int MLDSA_NAMESPACE(crypto_sign_verify_ctx_batch)(const uint8_t *const sigs[], const size_t siglens[],
+        const uint8_t *const msgs[], const size_t mlens[], size_t n,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *pk, uint8_t *ok);
+
+int MLDSA_NAMESPACE(crypto_sign_verify_ctx)(const uint8_t *sig, size_t siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *pk);
+
+int MLDSA_NAMESPACE(crypto_sign_open_ctx)(uint8_t *m, size_t *mlen,
+        const uint8_t *sm, size_t smlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const uint8_t *pk);
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef PQCLEAN_MLDSA_CLEAN_SYMMETRIC_H
+#define PQCLEAN_MLDSA_CLEAN_SYMMETRIC_H
+#include "fips202.h"
+#include "params.h"
+#include <stdint.h>
+
+
+typedef shake128incctx stream128_state;
+typedef shake256incctx stream256_state;
+typedef keccakx4_state stream128x4_state;
+typedef keccakx4_state stream256x4_state;
+
+void PQCLEAN_MLDSA_CLEAN_dilithium_shake128_stream_init(shake128incctx *state,
+        const uint8_t seed[SEEDBYTES],
+        uint16_t nonce);
+
+void PQCLEAN_MLDSA_CLEAN_dilithium_shake256_stream_init(shake256incctx *state,
+        const uint8_t seed[CRHBYTES],
+        uint16_t nonce);
+
+/* Four streams at once; lane j is initialized when bit j of mask is set */
+void PQCLEAN_MLDSA_CLEAN_dilithium_shake128x4_stream_init(keccakx4_state *state,
+        const uint8_t seed[SEEDBYTES],
+        const uint16_t nonce[4],
+        unsigned int mask);
+
+void PQCLEAN_MLDSA_CLEAN_dilithium_shake256x4_stream_init(keccakx4_state *state,
+        const uint8_t seed[CRHBYTES],
+        const uint16_t nonce[4],
+        unsigned int mask);
+
+#define STREAM128_BLOCKBYTES SHAKE128_RATE
+#define STREAM256_BLOCKBYTES SHAKE256_RATE
+
+#define stream128_init(STATE, SEED, NONCE) \
+    PQCLEAN_MLDSA_CLEAN_dilithium_shake128_stream_init(STATE, SEED, NONCE)
+#define stream128_squeezeblocks(OUT, OUTBLOCKS, STATE) \
+    shake128_inc_squeeze(OUT, (OUTBLOCKS)*(SHAKE128_RATE), STATE)
+#define stream128_release(STATE) shake128_inc_ctx_release(STATE)
+
+#define stream256_init(STATE, SEED, NONCE) \
+    PQCLEAN_MLDSA_CLEAN_dilithium_shake256_stream_init(STATE, SEED, NONCE)
+#define stream256_squeezeblocks(OUT, OUTBLOCKS, STATE) \
+    shake256_inc_squeeze(OUT, (OUTBLOCKS)*(SHAKE256_RATE), STATE)
+#define stream256_release(STATE) shake256_inc_ctx_release(STATE)
+
+#define stream128x4_init(STATE, SEED, NONCE, MASK) \
+    PQCLEAN_MLDSA_CLEAN_dilithium_shake128x4_stream_init(STATE, SEED, NONCE, MASK)
+#define stream128x4_squeezeblocks(OUT, OUTBLOCKS, STATE) \
+    shake128x4_squeezeblocks((OUT)[0], (OUT)[1], (OUT)[2], (OUT)[3], OUTBLOCKS, STATE)
+
+#define stream256x4_init(STATE, SEED, NONCE, MASK) \
+    PQCLEAN_MLDSA_CLEAN_dilithium_shake256x4_stream_init(STATE, SEED, NONCE, MASK)
+#define stream256x4_squeezeblocks(OUT, OUTBLOCKS, STATE) \
+    shake256x4_squeezeblocks((OUT)[0], (OUT)[1], (OUT)[2], (OUT)[3], OUTBLOCKS, STATE)
+
+#endif
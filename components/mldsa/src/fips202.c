@@ -0,0 +1,2074 @@
+/* Based on the public domain implementation in
+ * crypto_hash/keccakc512/simple/ from http://bench.cr.yp.to/supercop.html
+ * by Ronny Van Keer
+ * and the public domain "TweetFips202" implementation
+ * from https://twitter.com/tweetfips202
+ * by Gilles Van Assche, Daniel J. Bernstein, and Peter Schwabe */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "fips202.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+/* Keep the permutation in IRAM so it never waits on a flash cache miss */
+#define KECCAK_IRAM IRAM_ATTR
+#else
+#define KECCAK_IRAM
+#endif
+
+#define NROUNDS 24
+#define ROL(a, offset) (((a) << (offset)) ^ ((a) >> (64 - (offset))))
+#define ROL32(a, offset) (((a) << (offset)) ^ ((a) >> (32 - (offset))))
+
+/* Keccak-f[1600] backend selection.
+ * 0: the portable reference on 64-bit lanes.
+ * 1: a bit-interleaved backend for 32-bit cores. Every lane is kept as
+ *    its even and odd bits in two 32-bit words, and the state stays in
+ *    that form between permutations; bytes are converted on the way in
+ *    and out. Defaults to 1 on Xtensa, override with -DPQC_KECCAK_BI32=n. */
+#ifndef PQC_KECCAK_BI32
+#if defined(__XTENSA__)
+#define PQC_KECCAK_BI32 1
+#else
+#define PQC_KECCAK_BI32 0
+#endif
+#endif
+
+#if PQC_KECCAK_BI32
+
+/* Keccak round constants, split into their even and odd bits */
+static const uint32_t KeccakF_RoundConstantsBI[2 * NROUNDS] = {
+    0x00000001UL, 0x00000000UL, 0x00000000UL, 0x00000089UL,
+    0x00000000UL, 0x8000008bUL, 0x00000000UL, 0x80008080UL,
+    0x00000001UL, 0x0000008bUL, 0x00000001UL, 0x00008000UL,
+    0x00000001UL, 0x80008088UL, 0x00000001UL, 0x80000082UL,
+    0x00000000UL, 0x0000000bUL, 0x00000000UL, 0x0000000aUL,
+    0x00000001UL, 0x00008082UL, 0x00000000UL, 0x00008003UL,
+    0x00000001UL, 0x0000808bUL, 0x00000001UL, 0x8000000bUL,
+    0x00000001UL, 0x8000008aUL, 0x00000001UL, 0x80000081UL,
+    0x00000000UL, 0x80000081UL, 0x00000000UL, 0x80000008UL,
+    0x00000000UL, 0x00000083UL, 0x00000000UL, 0x80008003UL,
+    0x00000001UL, 0x80008088UL, 0x00000000UL, 0x80000088UL,
+    0x00000001UL, 0x00008000UL, 0x00000000UL, 0x80008082UL
+};
+
+/* Byte to (odd bits << 4 | even bits), and back */
+static const uint8_t keccak_bi_split[256] = {
+    0x00, 0x01, 0x10, 0x11, 0x02, 0x03, 0x12, 0x13, 0x20, 0x21, 0x30, 0x31, 0x22, 0x23, 0x32, 0x33,
+    0x04, 0x05, 0x14, 0x15, 0x06, 0x07, 0x16, 0x17, 0x24, 0x25, 0x34, 0x35, 0x26, 0x27, 0x36, 0x37,
+    0x40, 0x41, 0x50, 0x51, 0x42, 0x43, 0x52, 0x53, 0x60, 0x61, 0x70, 0x71, 0x62, 0x63, 0x72, 0x73,
+    0x44, 0x45, 0x54, 0x55, 0x46, 0x47, 0x56, 0x57, 0x64, 0x65, 0x74, 0x75, 0x66, 0x67, 0x76, 0x77,
+    0x08, 0x09, 0x18, 0x19, 0x0a, 0x0b, 0x1a, 0x1b, 0x28, 0x29, 0x38, 0x39, 0x2a, 0x2b, 0x3a, 0x3b,
+    0x0c, 0x0d, 0x1c, 0x1d, 0x0e, 0x0f, 0x1e, 0x1f, 0x2c, 0x2d, 0x3c, 0x3d, 0x2e, 0x2f, 0x3e, 0x3f,
+    0x48, 0x49, 0x58, 0x59, 0x4a, 0x4b, 0x5a, 0x5b, 0x68, 0x69, 0x78, 0x79, 0x6a, 0x6b, 0x7a, 0x7b,
+    0x4c, 0x4d, 0x5c, 0x5d, 0x4e, 0x4f, 0x5e, 0x5f, 0x6c, 0x6d, 0x7c, 0x7d, 0x6e, 0x6f, 0x7e, 0x7f,
+    0x80, 0x81, 0x90, 0x91, 0x82, 0x83, 0x92, 0x93, 0xa0, 0xa1, 0xb0, 0xb1, 0xa2, 0xa3, 0xb2, 0xb3,
+    0x84, 0x85, 0x94, 0x95, 0x86, 0x87, 0x96, 0x97, 0xa4, 0xa5, 0xb4, 0xb5, 0xa6, 0xa7, 0xb6, 0xb7,
+    0xc0, 0xc1, 0xd0, 0xd1, 0xc2, 0xc3, 0xd2, 0xd3, 0xe0, 0xe1, 0xf0, 0xf1, 0xe2, 0xe3, 0xf2, 0xf3,
+    0xc4, 0xc5, 0xd4, 0xd5, 0xc6, 0xc7, 0xd6, 0xd7, 0xe4, 0xe5, 0xf4, 0xf5, 0xe6, 0xe7, 0xf6, 0xf7,
+    0x88, 0x89, 0x98, 0x99, 0x8a, 0x8b, 0x9a, 0x9b, 0xa8, 0xa9, 0xb8, 0xb9, 0xaa, 0xab, 0xba, 0xbb,
+    0x8c, 0x8d, 0x9c, 0x9d, 0x8e, 0x8f, 0x9e, 0x9f, 0xac, 0xad, 0xbc, 0xbd, 0xae, 0xaf, 0xbe, 0xbf,
+    0xc8, 0xc9, 0xd8, 0xd9, 0xca, 0xcb, 0xda, 0xdb, 0xe8, 0xe9, 0xf8, 0xf9, 0xea, 0xeb, 0xfa, 0xfb,
+    0xcc, 0xcd, 0xdc, 0xdd, 0xce, 0xcf, 0xde, 0xdf, 0xec, 0xed, 0xfc, 0xfd, 0xee, 0xef, 0xfe, 0xff
+};
+
+static const uint8_t keccak_bi_merge[256] = {
+    0x00, 0x01, 0x04, 0x05, 0x10, 0x11, 0x14, 0x15, 0x40, 0x41, 0x44, 0x45, 0x50, 0x51, 0x54, 0x55,
+    0x02, 0x03, 0x06, 0x07, 0x12, 0x13, 0x16, 0x17, 0x42, 0x43, 0x46, 0x47, 0x52, 0x53, 0x56, 0x57,
+    0x08, 0x09, 0x0c, 0x0d, 0x18, 0x19, 0x1c, 0x1d, 0x48, 0x49, 0x4c, 0x4d, 0x58, 0x59, 0x5c, 0x5d,
+    0x0a, 0x0b, 0x0e, 0x0f, 0x1a, 0x1b, 0x1e, 0x1f, 0x4a, 0x4b, 0x4e, 0x4f, 0x5a, 0x5b, 0x5e, 0x5f,
+    0x20, 0x21, 0x24, 0x25, 0x30, 0x31, 0x34, 0x35, 0x60, 0x61, 0x64, 0x65, 0x70, 0x71, 0x74, 0x75,
+    0x22, 0x23, 0x26, 0x27, 0x32, 0x33, 0x36, 0x37, 0x62, 0x63, 0x66, 0x67, 0x72, 0x73, 0x76, 0x77,
+    0x28, 0x29, 0x2c, 0x2d, 0x38, 0x39, 0x3c, 0x3d, 0x68, 0x69, 0x6c, 0x6d, 0x78, 0x79, 0x7c, 0x7d,
+    0x2a, 0x2b, 0x2e, 0x2f, 0x3a, 0x3b, 0x3e, 0x3f, 0x6a, 0x6b, 0x6e, 0x6f, 0x7a, 0x7b, 0x7e, 0x7f,
+    0x80, 0x81, 0x84, 0x85, 0x90, 0x91, 0x94, 0x95, 0xc0, 0xc1, 0xc4, 0xc5, 0xd0, 0xd1, 0xd4, 0xd5,
+    0x82, 0x83, 0x86, 0x87, 0x92, 0x93, 0x96, 0x97, 0xc2, 0xc3, 0xc6, 0xc7, 0xd2, 0xd3, 0xd6, 0xd7,
+    0x88, 0x89, 0x8c, 0x8d, 0x98, 0x99, 0x9c, 0x9d, 0xc8, 0xc9, 0xcc, 0xcd, 0xd8, 0xd9, 0xdc, 0xdd,
+    0x8a, 0x8b, 0x8e, 0x8f, 0x9a, 0x9b, 0x9e, 0x9f, 0xca, 0xcb, 0xce, 0xcf, 0xda, 0xdb, 0xde, 0xdf,
+    0xa0, 0xa1, 0xa4, 0xa5, 0xb0, 0xb1, 0xb4, 0xb5, 0xe0, 0xe1, 0xe4, 0xe5, 0xf0, 0xf1, 0xf4, 0xf5,
+    0xa2, 0xa3, 0xa6, 0xa7, 0xb2, 0xb3, 0xb6, 0xb7, 0xe2, 0xe3, 0xe6, 0xe7, 0xf2, 0xf3, 0xf6, 0xf7,
+    0xa8, 0xa9, 0xac, 0xad, 0xb8, 0xb9, 0xbc, 0xbd, 0xe8, 0xe9, 0xec, 0xed, 0xf8, 0xf9, 0xfc, 0xfd,
+    0xaa, 0xab, 0xae, 0xaf, 0xba, 0xbb, 0xbe, 0xbf, 0xea, 0xeb, 0xee, 0xef, 0xfa, 0xfb, 0xfe, 0xff
+};
+
+/*************************************************
+ * Name:        keccak_xor_byte
+ *
+ * Description: XOR one byte into the bit-interleaved state
+ *
+ * Arguments:   - uint64_t *s: pointer to input/output Keccak state
+ *              - size_t pos: byte offset into the state
+ *              - uint8_t b: byte to XOR in
+ **************************************************/
+static inline void keccak_xor_byte(uint64_t *s, size_t pos, uint8_t b) {
+    uint32_t t = keccak_bi_split[b];
+    unsigned int sh = 4 * (pos & 0x07);
+    s[pos >> 3] ^= ((uint64_t)(t >> 4) << (32 + sh)) | ((uint64_t)(t & 0x0F) << sh);
+}
+
+/*************************************************
+ * Name:        keccak_get_byte
+ *
+ * Description: Extract one byte from the bit-interleaved state
+ *
+ * Arguments:   - const uint64_t *s: pointer to input Keccak state
+ *              - size_t pos: byte offset into the state
+ *
+ * Returns the byte at offset pos
+ **************************************************/
+static inline uint8_t keccak_get_byte(const uint64_t *s, size_t pos) {
+    unsigned int sh = 4 * (pos & 0x07);
+    uint32_t e = (uint32_t)s[pos >> 3];
+    uint32_t o = (uint32_t)(s[pos >> 3] >> 32);
+    return keccak_bi_merge[(((o >> sh) & 0x0F) << 4) | ((e >> sh) & 0x0F)];
+}
+
+/*************************************************
+ * Name:        keccak_xor_lane
+ *
+ * Description: XOR 8 little-endian bytes into lane i of the
+ *              bit-interleaved state
+ *
+ * Arguments:   - uint64_t *s: pointer to input/output Keccak state
+ *              - size_t i: lane index
+ *              - const uint8_t *x: pointer to 8 input bytes
+ **************************************************/
+static inline void keccak_xor_lane(uint64_t *s, size_t i, const uint8_t *x) {
+    uint32_t e = 0, o = 0, t;
+    for (size_t j = 0; j < 8; ++j) {
+        t = keccak_bi_split[x[j]];
+        e |= (t & 0x0F) << (4 * j);
+        o |= (t >> 4) << (4 * j);
+    }
+    s[i] ^= ((uint64_t)o << 32) | e;
+}
+
+/*************************************************
+ * Name:        keccak_get_lane
+ *
+ * Description: Store lane i of the bit-interleaved state as
+ *              8 little-endian bytes
+ *
+ * Arguments:   - uint8_t *x: pointer to 8 output bytes
+ *              - const uint64_t *s: pointer to input Keccak state
+ *              - size_t i: lane index
+ **************************************************/
+static inline void keccak_get_lane(uint8_t *x, const uint64_t *s, size_t i) {
+    uint32_t e = (uint32_t)s[i];
+    uint32_t o = (uint32_t)(s[i] >> 32);
+    for (size_t j = 0; j < 8; ++j) {
+        x[j] = keccak_bi_merge[(((o >> (4 * j)) & 0x0F) << 4) | ((e >> (4 * j)) & 0x0F)];
+    }
+}
+
+/*************************************************
+ * Name:        KeccakF1600_StatePermute
+ *
+ * Description: The Keccak F1600 Permutation on a bit-interleaved state.
+ *              Each lane is held as two 32-bit words with its even and odd
+ *              bits, so a 64-bit rotation becomes two 32-bit rotations.
+ *
+ * Arguments:   - uint64_t *state: pointer to input/output Keccak state
+ **************************************************/
+static KECCAK_IRAM void KeccakF1600_StatePermute(uint64_t *state) {
+    int round;
+
+    uint32_t Aba0, Aba1, Abe0, Abe1, Abi0, Abi1, Abo0, Abo1, Abu0, Abu1;
+    uint32_t Aga0, Aga1, Age0, Age1, Agi0, Agi1, Ago0, Ago1, Agu0, Agu1;
+    uint32_t Aka0, Aka1, Ake0, Ake1, Aki0, Aki1, Ako0, Ako1, Aku0, Aku1;
+    uint32_t Ama0, Ama1, Ame0, Ame1, Ami0, Ami1, Amo0, Amo1, Amu0, Amu1;
+    uint32_t Asa0, Asa1, Ase0, Ase1, Asi0, Asi1, Aso0, Aso1, Asu0, Asu1;
+    uint32_t BCa0, BCa1, BCe0, BCe1, BCi0, BCi1, BCo0, BCo1, BCu0, BCu1;
+    uint32_t Da0, Da1, De0, De1, Di0, Di1, Do0, Do1, Du0, Du1;
+    uint32_t Eba0, Eba1, Ebe0, Ebe1, Ebi0, Ebi1, Ebo0, Ebo1, Ebu0, Ebu1;
+    uint32_t Ega0, Ega1, Ege0, Ege1, Egi0, Egi1, Ego0, Ego1, Egu0, Egu1;
+    uint32_t Eka0, Eka1, Eke0, Eke1, Eki0, Eki1, Eko0, Eko1, Eku0, Eku1;
+    uint32_t Ema0, Ema1, Eme0, Eme1, Emi0, Emi1, Emo0, Emo1, Emu0, Emu1;
+    uint32_t Esa0, Esa1, Ese0, Ese1, Esi0, Esi1, Eso0, Eso1, Esu0, Esu1;
+
+    // copyFromState(A, state)
+    Aba0 = (uint32_t)state[0];
+    Aba1 = (uint32_t)(state[0] >> 32);
+    Abe0 = (uint32_t)state[1];
+    Abe1 = (uint32_t)(state[1] >> 32);
+    Abi0 = (uint32_t)state[2];
+    Abi1 = (uint32_t)(state[2] >> 32);
+    Abo0 = (uint32_t)state[3];
+    Abo1 = (uint32_t)(state[3] >> 32);
+    Abu0 = (uint32_t)state[4];
+    Abu1 = (uint32_t)(state[4] >> 32);
+    Aga0 = (uint32_t)state[5];
+    Aga1 = (uint32_t)(state[5] >> 32);
+    Age0 = (uint32_t)state[6];
+    Age1 = (uint32_t)(state[6] >> 32);
+    Agi0 = (uint32_t)state[7];
+    Agi1 = (uint32_t)(state[7] >> 32);
+    Ago0 = (uint32_t)state[8];
+    Ago1 = (uint32_t)(state[8] >> 32);
+    Agu0 = (uint32_t)state[9];
+    Agu1 = (uint32_t)(state[9] >> 32);
+    Aka0 = (uint32_t)state[10];
+    Aka1 = (uint32_t)(state[10] >> 32);
+    Ake0 = (uint32_t)state[11];
+    Ake1 = (uint32_t)(state[11] >> 32);
+    Aki0 = (uint32_t)state[12];
+    Aki1 = (uint32_t)(state[12] >> 32);
+    Ako0 = (uint32_t)state[13];
+    Ako1 = (uint32_t)(state[13] >> 32);
+    Aku0 = (uint32_t)state[14];
+    Aku1 = (uint32_t)(state[14] >> 32);
+    Ama0 = (uint32_t)state[15];
+    Ama1 = (uint32_t)(state[15] >> 32);
+    Ame0 = (uint32_t)state[16];
+    Ame1 = (uint32_t)(state[16] >> 32);
+    Ami0 = (uint32_t)state[17];
+    Ami1 = (uint32_t)(state[17] >> 32);
+    Amo0 = (uint32_t)state[18];
+    Amo1 = (uint32_t)(state[18] >> 32);
+    Amu0 = (uint32_t)state[19];
+    Amu1 = (uint32_t)(state[19] >> 32);
+    Asa0 = (uint32_t)state[20];
+    Asa1 = (uint32_t)(state[20] >> 32);
+    Ase0 = (uint32_t)state[21];
+    Ase1 = (uint32_t)(state[21] >> 32);
+    Asi0 = (uint32_t)state[22];
+    Asi1 = (uint32_t)(state[22] >> 32);
+    Aso0 = (uint32_t)state[23];
+    Aso1 = (uint32_t)(state[23] >> 32);
+    Asu0 = (uint32_t)state[24];
+    Asu1 = (uint32_t)(state[24] >> 32);
+
+    for (round = 0; round < NROUNDS; round += 2) {
+        //    prepareTheta
+        BCa0 = Aba0 ^ Aga0 ^ Aka0 ^ Ama0 ^ Asa0;
+        BCa1 = Aba1 ^ Aga1 ^ Aka1 ^ Ama1 ^ Asa1;
+        BCe0 = Abe0 ^ Age0 ^ Ake0 ^ Ame0 ^ Ase0;
+        BCe1 = Abe1 ^ Age1 ^ Ake1 ^ Ame1 ^ Ase1;
+        BCi0 = Abi0 ^ Agi0 ^ Aki0 ^ Ami0 ^ Asi0;
+        BCi1 = Abi1 ^ Agi1 ^ Aki1 ^ Ami1 ^ Asi1;
+        BCo0 = Abo0 ^ Ago0 ^ Ako0 ^ Amo0 ^ Aso0;
+        BCo1 = Abo1 ^ Ago1 ^ Ako1 ^ Amo1 ^ Aso1;
+        BCu0 = Abu0 ^ Agu0 ^ Aku0 ^ Amu0 ^ Asu0;
+        BCu1 = Abu1 ^ Agu1 ^ Aku1 ^ Amu1 ^ Asu1;
+
+        // thetaRhoPiChiIotaPrepareTheta(round  , A, E)
+        Da0 = BCu0 ^ ROL32(BCe1, 1);
+        Da1 = BCu1 ^ BCe0;
+        De0 = BCa0 ^ ROL32(BCi1, 1);
+        De1 = BCa1 ^ BCi0;
+        Di0 = BCe0 ^ ROL32(BCo1, 1);
+        Di1 = BCe1 ^ BCo0;
+        Do0 = BCi0 ^ ROL32(BCu1, 1);
+        Do1 = BCi1 ^ BCu0;
+        Du0 = BCo0 ^ ROL32(BCa1, 1);
+        Du1 = BCo1 ^ BCa0;
+
+        Aba0 ^= Da0;
+        Aba1 ^= Da1;
+        BCa0 = Aba0;
+        BCa1 = Aba1;
+        Age0 ^= De0;
+        Age1 ^= De1;
+        BCe0 = ROL32(Age0, 22);
+        BCe1 = ROL32(Age1, 22);
+        Aki0 ^= Di0;
+        Aki1 ^= Di1;
+        BCi0 = ROL32(Aki1, 22);
+        BCi1 = ROL32(Aki0, 21);
+        Amo0 ^= Do0;
+        Amo1 ^= Do1;
+        BCo0 = ROL32(Amo1, 11);
+        BCo1 = ROL32(Amo0, 10);
+        Asu0 ^= Du0;
+        Asu1 ^= Du1;
+        BCu0 = ROL32(Asu0, 7);
+        BCu1 = ROL32(Asu1, 7);
+        Eba0 = BCa0 ^ ((~BCe0) & BCi0);
+        Eba1 = BCa1 ^ ((~BCe1) & BCi1);
+        Eba0 ^= KeccakF_RoundConstantsBI[2 * (round) + 0];
+        Eba1 ^= KeccakF_RoundConstantsBI[2 * (round) + 1];
+        Ebe0 = BCe0 ^ ((~BCi0) & BCo0);
+        Ebe1 = BCe1 ^ ((~BCi1) & BCo1);
+        Ebi0 = BCi0 ^ ((~BCo0) & BCu0);
+        Ebi1 = BCi1 ^ ((~BCo1) & BCu1);
+        Ebo0 = BCo0 ^ ((~BCu0) & BCa0);
+        Ebo1 = BCo1 ^ ((~BCu1) & BCa1);
+        Ebu0 = BCu0 ^ ((~BCa0) & BCe0);
+        Ebu1 = BCu1 ^ ((~BCa1) & BCe1);
+
+        Abo0 ^= Do0;
+        Abo1 ^= Do1;
+        BCa0 = ROL32(Abo0, 14);
+        BCa1 = ROL32(Abo1, 14);
+        Agu0 ^= Du0;
+        Agu1 ^= Du1;
+        BCe0 = ROL32(Agu0, 10);
+        BCe1 = ROL32(Agu1, 10);
+        Aka0 ^= Da0;
+        Aka1 ^= Da1;
+        BCi0 = ROL32(Aka1, 2);
+        BCi1 = ROL32(Aka0, 1);
+        Ame0 ^= De0;
+        Ame1 ^= De1;
+        BCo0 = ROL32(Ame1, 23);
+        BCo1 = ROL32(Ame0, 22);
+        Asi0 ^= Di0;
+        Asi1 ^= Di1;
+        BCu0 = ROL32(Asi1, 31);
+        BCu1 = ROL32(Asi0, 30);
+        Ega0 = BCa0 ^ ((~BCe0) & BCi0);
+        Ega1 = BCa1 ^ ((~BCe1) & BCi1);
+        Ege0 = BCe0 ^ ((~BCi0) & BCo0);
+        Ege1 = BCe1 ^ ((~BCi1) & BCo1);
+        Egi0 = BCi0 ^ ((~BCo0) & BCu0);
+        Egi1 = BCi1 ^ ((~BCo1) & BCu1);
+        Ego0 = BCo0 ^ ((~BCu0) & BCa0);
+        Ego1 = BCo1 ^ ((~BCu1) & BCa1);
+        Egu0 = BCu0 ^ ((~BCa0) & BCe0);
+        Egu1 = BCu1 ^ ((~BCa1) & BCe1);
+
+        Abe0 ^= De0;
+        Abe1 ^= De1;
+        BCa0 = ROL32(Abe1, 1);
+        BCa1 = Abe0;
+        Agi0 ^= Di0;
+        Agi1 ^= Di1;
+        BCe0 = ROL32(Agi0, 3);
+        BCe1 = ROL32(Agi1, 3);
+        Ako0 ^= Do0;
+        Ako1 ^= Do1;
+        BCi0 = ROL32(Ako1, 13);
+        BCi1 = ROL32(Ako0, 12);
+        Amu0 ^= Du0;
+        Amu1 ^= Du1;
+        BCo0 = ROL32(Amu0, 4);
+        BCo1 = ROL32(Amu1, 4);
+        Asa0 ^= Da0;
+        Asa1 ^= Da1;
+        BCu0 = ROL32(Asa0, 9);
+        BCu1 = ROL32(Asa1, 9);
+        Eka0 = BCa0 ^ ((~BCe0) & BCi0);
+        Eka1 = BCa1 ^ ((~BCe1) & BCi1);
+        Eke0 = BCe0 ^ ((~BCi0) & BCo0);
+        Eke1 = BCe1 ^ ((~BCi1) & BCo1);
+        Eki0 = BCi0 ^ ((~BCo0) & BCu0);
+        Eki1 = BCi1 ^ ((~BCo1) & BCu1);
+        Eko0 = BCo0 ^ ((~BCu0) & BCa0);
+        Eko1 = BCo1 ^ ((~BCu1) & BCa1);
+        Eku0 = BCu0 ^ ((~BCa0) & BCe0);
+        Eku1 = BCu1 ^ ((~BCa1) & BCe1);
+
+        Abu0 ^= Du0;
+        Abu1 ^= Du1;
+        BCa0 = ROL32(Abu1, 14);
+        BCa1 = ROL32(Abu0, 13);
+        Aga0 ^= Da0;
+        Aga1 ^= Da1;
+        BCe0 = ROL32(Aga0, 18);
+        BCe1 = ROL32(Aga1, 18);
+        Ake0 ^= De0;
+        Ake1 ^= De1;
+        BCi0 = ROL32(Ake0, 5);
+        BCi1 = ROL32(Ake1, 5);
+        Ami0 ^= Di0;
+        Ami1 ^= Di1;
+        BCo0 = ROL32(Ami1, 8);
+        BCo1 = ROL32(Ami0, 7);
+        Aso0 ^= Do0;
+        Aso1 ^= Do1;
+        BCu0 = ROL32(Aso0, 28);
+        BCu1 = ROL32(Aso1, 28);
+        Ema0 = BCa0 ^ ((~BCe0) & BCi0);
+        Ema1 = BCa1 ^ ((~BCe1) & BCi1);
+        Eme0 = BCe0 ^ ((~BCi0) & BCo0);
+        Eme1 = BCe1 ^ ((~BCi1) & BCo1);
+        Emi0 = BCi0 ^ ((~BCo0) & BCu0);
+        Emi1 = BCi1 ^ ((~BCo1) & BCu1);
+        Emo0 = BCo0 ^ ((~BCu0) & BCa0);
+        Emo1 = BCo1 ^ ((~BCu1) & BCa1);
+        Emu0 = BCu0 ^ ((~BCa0) & BCe0);
+        Emu1 = BCu1 ^ ((~BCa1) & BCe1);
+
+        Abi0 ^= Di0;
+        Abi1 ^= Di1;
+        BCa0 = ROL32(Abi0, 31);
+        BCa1 = ROL32(Abi1, 31);
+        Ago0 ^= Do0;
+        Ago1 ^= Do1;
+        BCe0 = ROL32(Ago1, 28);
+        BCe1 = ROL32(Ago0, 27);
+        Aku0 ^= Du0;
+        Aku1 ^= Du1;
+        BCi0 = ROL32(Aku1, 20);
+        BCi1 = ROL32(Aku0, 19);
+        Ama0 ^= Da0;
+        Ama1 ^= Da1;
+        BCo0 = ROL32(Ama1, 21);
+        BCo1 = ROL32(Ama0, 20);
+        Ase0 ^= De0;
+        Ase1 ^= De1;
+        BCu0 = ROL32(Ase0, 1);
+        BCu1 = ROL32(Ase1, 1);
+        Esa0 = BCa0 ^ ((~BCe0) & BCi0);
+        Esa1 = BCa1 ^ ((~BCe1) & BCi1);
+        Ese0 = BCe0 ^ ((~BCi0) & BCo0);
+        Ese1 = BCe1 ^ ((~BCi1) & BCo1);
+        Esi0 = BCi0 ^ ((~BCo0) & BCu0);
+        Esi1 = BCi1 ^ ((~BCo1) & BCu1);
+        Eso0 = BCo0 ^ ((~BCu0) & BCa0);
+        Eso1 = BCo1 ^ ((~BCu1) & BCa1);
+        Esu0 = BCu0 ^ ((~BCa0) & BCe0);
+        Esu1 = BCu1 ^ ((~BCa1) & BCe1);
+
+        //    prepareTheta
+        BCa0 = Eba0 ^ Ega0 ^ Eka0 ^ Ema0 ^ Esa0;
+        BCa1 = Eba1 ^ Ega1 ^ Eka1 ^ Ema1 ^ Esa1;
+        BCe0 = Ebe0 ^ Ege0 ^ Eke0 ^ Eme0 ^ Ese0;
+        BCe1 = Ebe1 ^ Ege1 ^ Eke1 ^ Eme1 ^ Ese1;
+        BCi0 = Ebi0 ^ Egi0 ^ Eki0 ^ Emi0 ^ Esi0;
+        BCi1 = Ebi1 ^ Egi1 ^ Eki1 ^ Emi1 ^ Esi1;
+        BCo0 = Ebo0 ^ Ego0 ^ Eko0 ^ Emo0 ^ Eso0;
+        BCo1 = Ebo1 ^ Ego1 ^ Eko1 ^ Emo1 ^ Eso1;
+        BCu0 = Ebu0 ^ Egu0 ^ Eku0 ^ Emu0 ^ Esu0;
+        BCu1 = Ebu1 ^ Egu1 ^ Eku1 ^ Emu1 ^ Esu1;
+
+        // thetaRhoPiChiIotaPrepareTheta(round+1, E, A)
+        Da0 = BCu0 ^ ROL32(BCe1, 1);
+        Da1 = BCu1 ^ BCe0;
+        De0 = BCa0 ^ ROL32(BCi1, 1);
+        De1 = BCa1 ^ BCi0;
+        Di0 = BCe0 ^ ROL32(BCo1, 1);
+        Di1 = BCe1 ^ BCo0;
+        Do0 = BCi0 ^ ROL32(BCu1, 1);
+        Do1 = BCi1 ^ BCu0;
+        Du0 = BCo0 ^ ROL32(BCa1, 1);
+        Du1 = BCo1 ^ BCa0;
+
+        Eba0 ^= Da0;
+        Eba1 ^= Da1;
+        BCa0 = Eba0;
+        BCa1 = Eba1;
+        Ege0 ^= De0;
+        Ege1 ^= De1;
+        BCe0 = ROL32(Ege0, 22);
+        BCe1 = ROL32(Ege1, 22);
+        Eki0 ^= Di0;
+        Eki1 ^= Di1;
+        BCi0 = ROL32(Eki1, 22);
+        BCi1 = ROL32(Eki0, 21);
+        Emo0 ^= Do0;
+        Emo1 ^= Do1;
+        BCo0 = ROL32(Emo1, 11);
+        BCo1 = ROL32(Emo0, 10);
+        Esu0 ^= Du0;
+        Esu1 ^= Du1;
+        BCu0 = ROL32(Esu0, 7);
+        BCu1 = ROL32(Esu1, 7);
+        Aba0 = BCa0 ^ ((~BCe0) & BCi0);
+        Aba1 = BCa1 ^ ((~BCe1) & BCi1);
+        Aba0 ^= KeccakF_RoundConstantsBI[2 * (round + 1) + 0];
+        Aba1 ^= KeccakF_RoundConstantsBI[2 * (round + 1) + 1];
+        Abe0 = BCe0 ^ ((~BCi0) & BCo0);
+        Abe1 = BCe1 ^ ((~BCi1) & BCo1);
+        Abi0 = BCi0 ^ ((~BCo0) & BCu0);
+        Abi1 = BCi1 ^ ((~BCo1) & BCu1);
+        Abo0 = BCo0 ^ ((~BCu0) & BCa0);
+        Abo1 = BCo1 ^ ((~BCu1) & BCa1);
+        Abu0 = BCu0 ^ ((~BCa0) & BCe0);
+        Abu1 = BCu1 ^ ((~BCa1) & BCe1);
+
+        Ebo0 ^= Do0;
+        Ebo1 ^= Do1;
+        BCa0 = ROL32(Ebo0, 14);
+        BCa1 = ROL32(Ebo1, 14);
+        Egu0 ^= Du0;
+        Egu1 ^= Du1;
+        BCe0 = ROL32(Egu0, 10);
+        BCe1 = ROL32(Egu1, 10);
+        Eka0 ^= Da0;
+        Eka1 ^= Da1;
+        BCi0 = ROL32(Eka1, 2);
+        BCi1 = ROL32(Eka0, 1);
+        Eme0 ^= De0;
+        Eme1 ^= De1;
+        BCo0 = ROL32(Eme1, 23);
+        BCo1 = ROL32(Eme0, 22);
+        Esi0 ^= Di0;
+        Esi1 ^= Di1;
+        BCu0 = ROL32(Esi1, 31);
+        BCu1 = ROL32(Esi0, 30);
+        Aga0 = BCa0 ^ ((~BCe0) & BCi0);
+        Aga1 = BCa1 ^ ((~BCe1) & BCi1);
+        Age0 = BCe0 ^ ((~BCi0) & BCo0);
+        Age1 = BCe1 ^ ((~BCi1) & BCo1);
+        Agi0 = BCi0 ^ ((~BCo0) & BCu0);
+        Agi1 = BCi1 ^ ((~BCo1) & BCu1);
+        Ago0 = BCo0 ^ ((~BCu0) & BCa0);
+        Ago1 = BCo1 ^ ((~BCu1) & BCa1);
+        Agu0 = BCu0 ^ ((~BCa0) & BCe0);
+        Agu1 = BCu1 ^ ((~BCa1) & BCe1);
+
+        Ebe0 ^= De0;
+        Ebe1 ^= De1;
+        BCa0 = ROL32(Ebe1, 1);
+        BCa1 = Ebe0;
+        Egi0 ^= Di0;
+        Egi1 ^= Di1;
+        BCe0 = ROL32(Egi0, 3);
+        BCe1 = ROL32(Egi1, 3);
+        Eko0 ^= Do0;
+        Eko1 ^= Do1;
+        BCi0 = ROL32(Eko1, 13);
+        BCi1 = ROL32(Eko0, 12);
+        Emu0 ^= Du0;
+        Emu1 ^= Du1;
+        BCo0 = ROL32(Emu0, 4);
+        BCo1 = ROL32(Emu1, 4);
+        Esa0 ^= Da0;
+        Esa1 ^= Da1;
+        BCu0 = ROL32(Esa0, 9);
+        BCu1 = ROL32(Esa1, 9);
+        Aka0 = BCa0 ^ ((~BCe0) & BCi0);
+        Aka1 = BCa1 ^ ((~BCe1) & BCi1);
+        Ake0 = BCe0 ^ ((~BCi0) & BCo0);
+        Ake1 = BCe1 ^ ((~BCi1) & BCo1);
+        Aki0 = BCi0 ^ ((~BCo0) & BCu0);
+        Aki1 = BCi1 ^ ((~BCo1) & BCu1);
+        Ako0 = BCo0 ^ ((~BCu0) & BCa0);
+        Ako1 = BCo1 ^ ((~BCu1) & BCa1);
+        Aku0 = BCu0 ^ ((~BCa0) & BCe0);
+        Aku1 = BCu1 ^ ((~BCa1) & BCe1);
+
+        Ebu0 ^= Du0;
+        Ebu1 ^= Du1;
+        BCa0 = ROL32(Ebu1, 14);
+        BCa1 = ROL32(Ebu0, 13);
+        Ega0 ^= Da0;
+        Ega1 ^= Da1;
+        BCe0 = ROL32(Ega0, 18);
+        BCe1 = ROL32(Ega1, 18);
+        Eke0 ^= De0;
+        Eke1 ^= De1;
+        BCi0 = ROL32(Eke0, 5);
+        BCi1 = ROL32(Eke1, 5);
+        Emi0 ^= Di0;
+        Emi1 ^= Di1;
+        BCo0 = ROL32(Emi1, 8);
+        BCo1 = ROL32(Emi0, 7);
+        Eso0 ^= Do0;
+        Eso1 ^= Do1;
+        BCu0 = ROL32(Eso0, 28);
+        BCu1 = ROL32(Eso1, 28);
+        Ama0 = BCa0 ^ ((~BCe0) & BCi0);
+        Ama1 = BCa1 ^ ((~BCe1) & BCi1);
+        Ame0 = BCe0 ^ ((~BCi0) & BCo0);
+        Ame1 = BCe1 ^ ((~BCi1) & BCo1);
+        Ami0 = BCi0 ^ ((~BCo0) & BCu0);
+        Ami1 = BCi1 ^ ((~BCo1) & BCu1);
+        Amo0 = BCo0 ^ ((~BCu0) & BCa0);
+        Amo1 = BCo1 ^ ((~BCu1) & BCa1);
+        Amu0 = BCu0 ^ ((~BCa0) & BCe0);
+        Amu1 = BCu1 ^ ((~BCa1) & BCe1);
+
+        Ebi0 ^= Di0;
+        Ebi1 ^= Di1;
+        BCa0 = ROL32(Ebi0, 31);
+        BCa1 = ROL32(Ebi1, 31);
+        Ego0 ^= Do0;
+        Ego1 ^= Do1;
+        BCe0 = ROL32(Ego1, 28);
+        BCe1 = ROL32(Ego0, 27);
+        Eku0 ^= Du0;
+        Eku1 ^= Du1;
+        BCi0 = ROL32(Eku1, 20);
+        BCi1 = ROL32(Eku0, 19);
+        Ema0 ^= Da0;
+        Ema1 ^= Da1;
+        BCo0 = ROL32(Ema1, 21);
+        BCo1 = ROL32(Ema0, 20);
+        Ese0 ^= De0;
+        Ese1 ^= De1;
+        BCu0 = ROL32(Ese0, 1);
+        BCu1 = ROL32(Ese1, 1);
+        Asa0 = BCa0 ^ ((~BCe0) & BCi0);
+        Asa1 = BCa1 ^ ((~BCe1) & BCi1);
+        Ase0 = BCe0 ^ ((~BCi0) & BCo0);
+        Ase1 = BCe1 ^ ((~BCi1) & BCo1);
+        Asi0 = BCi0 ^ ((~BCo0) & BCu0);
+        Asi1 = BCi1 ^ ((~BCo1) & BCu1);
+        Aso0 = BCo0 ^ ((~BCu0) & BCa0);
+        Aso1 = BCo1 ^ ((~BCu1) & BCa1);
+        Asu0 = BCu0 ^ ((~BCa0) & BCe0);
+        Asu1 = BCu1 ^ ((~BCa1) & BCe1);
+    }
+
+    // copyToState(state, A)
+    state[0] = ((uint64_t)Aba1 << 32) | Aba0;
+    state[1] = ((uint64_t)Abe1 << 32) | Abe0;
+    state[2] = ((uint64_t)Abi1 << 32) | Abi0;
+    state[3] = ((uint64_t)Abo1 << 32) | Abo0;
+    state[4] = ((uint64_t)Abu1 << 32) | Abu0;
+    state[5] = ((uint64_t)Aga1 << 32) | Aga0;
+    state[6] = ((uint64_t)Age1 << 32) | Age0;
+    state[7] = ((uint64_t)Agi1 << 32) | Agi0;
+    state[8] = ((uint64_t)Ago1 << 32) | Ago0;
+    state[9] = ((uint64_t)Agu1 << 32) | Agu0;
+    state[10] = ((uint64_t)Aka1 << 32) | Aka0;
+    state[11] = ((uint64_t)Ake1 << 32) | Ake0;
+    state[12] = ((uint64_t)Aki1 << 32) | Aki0;
+    state[13] = ((uint64_t)Ako1 << 32) | Ako0;
+    state[14] = ((uint64_t)Aku1 << 32) | Aku0;
+    state[15] = ((uint64_t)Ama1 << 32) | Ama0;
+    state[16] = ((uint64_t)Ame1 << 32) | Ame0;
+    state[17] = ((uint64_t)Ami1 << 32) | Ami0;
+    state[18] = ((uint64_t)Amo1 << 32) | Amo0;
+    state[19] = ((uint64_t)Amu1 << 32) | Amu0;
+    state[20] = ((uint64_t)Asa1 << 32) | Asa0;
+    state[21] = ((uint64_t)Ase1 << 32) | Ase0;
+    state[22] = ((uint64_t)Asi1 << 32) | Asi0;
+    state[23] = ((uint64_t)Aso1 << 32) | Aso0;
+    state[24] = ((uint64_t)Asu1 << 32) | Asu0;
+}
+
+#else
+
+/*************************************************
+ * Name:        load64
+ *
+ * Description: Load 8 bytes into uint64_t in little-endian order
+ *
+ * Arguments:   - const uint8_t *x: pointer to input byte array
+ *
+ * Returns the loaded 64-bit unsigned integer
+ **************************************************/
+static uint64_t load64(const uint8_t *x) {
+    uint64_t r = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        r |= (uint64_t)x[i] << 8 * i;
+    }
+
+    return r;
+}
+
+/*************************************************
+ * Name:        store64
+ *
+ * Description: Store a 64-bit integer to a byte array in little-endian order
+ *
+ * Arguments:   - uint8_t *x: pointer to the output byte array
+ *              - uint64_t u: input 64-bit unsigned integer
+ **************************************************/
+static void store64(uint8_t *x, uint64_t u) {
+    for (size_t i = 0; i < 8; ++i) {
+        x[i] = (uint8_t) (u >> 8 * i);
+    }
+}
+
+/* Keccak round constants */
+static const uint64_t KeccakF_RoundConstants[NROUNDS] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL,
+    0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL,
+    0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL,
+    0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL,
+    0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+/*************************************************
+ * Name:        KeccakF1600_StatePermute
+ *
+ * Description: The Keccak F1600 Permutation
+ *
+ * Arguments:   - uint64_t *state: pointer to input/output Keccak state
+ **************************************************/
+static KECCAK_IRAM void KeccakF1600_StatePermute(uint64_t *state) {
+    int round;
+
+    uint64_t Aba, Abe, Abi, Abo, Abu;
+    uint64_t Aga, Age, Agi, Ago, Agu;
+    uint64_t Aka, Ake, Aki, Ako, Aku;
+    uint64_t Ama, Ame, Ami, Amo, Amu;
+    uint64_t Asa, Ase, Asi, Aso, Asu;
+    uint64_t BCa, BCe, BCi, BCo, BCu;
+    uint64_t Da, De, Di, Do, Du;
+    uint64_t Eba, Ebe, Ebi, Ebo, Ebu;
+    uint64_t Ega, Ege, Egi, Ego, Egu;
+    uint64_t Eka, Eke, Eki, Eko, Eku;
+    uint64_t Ema, Eme, Emi, Emo, Emu;
+    uint64_t Esa, Ese, Esi, Eso, Esu;
+
+    // copyFromState(A, state)
+    Aba = state[0];
+    Abe = state[1];
+    Abi = state[2];
+    Abo = state[3];
+    Abu = state[4];
+    Aga = state[5];
+    Age = state[6];
+    Agi = state[7];
+    Ago = state[8];
+    Agu = state[9];
+    Aka = state[10];
+    Ake = state[11];
+    Aki = state[12];
+    Ako = state[13];
+    Aku = state[14];
+    Ama = state[15];
+    Ame = state[16];
+    Ami = state[17];
+    Amo = state[18];
+    Amu = state[19];
+    Asa = state[20];
+    Ase = state[21];
+    Asi = state[22];
+    Aso = state[23];
+    Asu = state[24];
+
+    for (round = 0; round < NROUNDS; round += 2) {
+        //    prepareTheta
+        BCa = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+        BCe = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+        BCi = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+        BCo = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+        BCu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+
+        // thetaRhoPiChiIotaPrepareTheta(round  , A, E)
+        Da = BCu ^ ROL(BCe, 1);
+        De = BCa ^ ROL(BCi, 1);
+        Di = BCe ^ ROL(BCo, 1);
+        Do = BCi ^ ROL(BCu, 1);
+        Du = BCo ^ ROL(BCa, 1);
+
+        Aba ^= Da;
+        BCa = Aba;
+        Age ^= De;
+        BCe = ROL(Age, 44);
+        Aki ^= Di;
+        BCi = ROL(Aki, 43);
+        Amo ^= Do;
+        BCo = ROL(Amo, 21);
+        Asu ^= Du;
+        BCu = ROL(Asu, 14);
+        Eba = BCa ^ ((~BCe) & BCi);
+        Eba ^= KeccakF_RoundConstants[round];
+        Ebe = BCe ^ ((~BCi) & BCo);
+        Ebi = BCi ^ ((~BCo) & BCu);
+        Ebo = BCo ^ ((~BCu) & BCa);
+        Ebu = BCu ^ ((~BCa) & BCe);
+
+        Abo ^= Do;
+        BCa = ROL(Abo, 28);
+        Agu ^= Du;
+        BCe = ROL(Agu, 20);
+        Aka ^= Da;
+        BCi = ROL(Aka, 3);
+        Ame ^= De;
+        BCo = ROL(Ame, 45);
+        Asi ^= Di;
+        BCu = ROL(Asi, 61);
+        Ega = BCa ^ ((~BCe) & BCi);
+        Ege = BCe ^ ((~BCi) & BCo);
+        Egi = BCi ^ ((~BCo) & BCu);
+        Ego = BCo ^ ((~BCu) & BCa);
+        Egu = BCu ^ ((~BCa) & BCe);
+
+        Abe ^= De;
+        BCa = ROL(Abe, 1);
+        Agi ^= Di;
+        BCe = ROL(Agi, 6);
+        Ako ^= Do;
+        BCi = ROL(Ako, 25);
+        Amu ^= Du;
+        BCo = ROL(Amu, 8);
+        Asa ^= Da;
+        BCu = ROL(Asa, 18);
+        Eka = BCa ^ ((~BCe) & BCi);
+        Eke = BCe ^ ((~BCi) & BCo);
+        Eki = BCi ^ ((~BCo) & BCu);
+        Eko = BCo ^ ((~BCu) & BCa);
+        Eku = BCu ^ ((~BCa) & BCe);
+
+        Abu ^= Du;
+        BCa = ROL(Abu, 27);
+        Aga ^= Da;
+        BCe = ROL(Aga, 36);
+        Ake ^= De;
+        BCi = ROL(Ake, 10);
+        Ami ^= Di;
+        BCo = ROL(Ami, 15);
+        Aso ^= Do;
+        BCu = ROL(Aso, 56);
+        Ema = BCa ^ ((~BCe) & BCi);
+        Eme = BCe ^ ((~BCi) & BCo);
+        Emi = BCi ^ ((~BCo) & BCu);
+        Emo = BCo ^ ((~BCu) & BCa);
+        Emu = BCu ^ ((~BCa) & BCe);
+
+        Abi ^= Di;
+        BCa = ROL(Abi, 62);
+        Ago ^= Do;
+        BCe = ROL(Ago, 55);
+        Aku ^= Du;
+        BCi = ROL(Aku, 39);
+        Ama ^= Da;
+        BCo = ROL(Ama, 41);
+        Ase ^= De;
+        BCu = ROL(Ase, 2);
+        Esa = BCa ^ ((~BCe) & BCi);
+        Ese = BCe ^ ((~BCi) & BCo);
+        Esi = BCi ^ ((~BCo) & BCu);
+        Eso = BCo ^ ((~BCu) & BCa);
+        Esu = BCu ^ ((~BCa) & BCe);
+
+        //    prepareTheta
+        BCa = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+        BCe = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+        BCi = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+        BCo = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+        BCu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+
+        // thetaRhoPiChiIotaPrepareTheta(round+1, E, A)
+        Da = BCu ^ ROL(BCe, 1);
+        De = BCa ^ ROL(BCi, 1);
+        Di = BCe ^ ROL(BCo, 1);
+        Do = BCi ^ ROL(BCu, 1);
+        Du = BCo ^ ROL(BCa, 1);
+
+        Eba ^= Da;
+        BCa = Eba;
+        Ege ^= De;
+        BCe = ROL(Ege, 44);
+        Eki ^= Di;
+        BCi = ROL(Eki, 43);
+        Emo ^= Do;
+        BCo = ROL(Emo, 21);
+        Esu ^= Du;
+        BCu = ROL(Esu, 14);
+        Aba = BCa ^ ((~BCe) & BCi);
+        Aba ^= KeccakF_RoundConstants[round + 1];
+        Abe = BCe ^ ((~BCi) & BCo);
+        Abi = BCi ^ ((~BCo) & BCu);
+        Abo = BCo ^ ((~BCu) & BCa);
+        Abu = BCu ^ ((~BCa) & BCe);
+
+        Ebo ^= Do;
+        BCa = ROL(Ebo, 28);
+        Egu ^= Du;
+        BCe = ROL(Egu, 20);
+        Eka ^= Da;
+        BCi = ROL(Eka, 3);
+        Eme ^= De;
+        BCo = ROL(Eme, 45);
+        Esi ^= Di;
+        BCu = ROL(Esi, 61);
+        Aga = BCa ^ ((~BCe) & BCi);
+        Age = BCe ^ ((~BCi) & BCo);
+        Agi = BCi ^ ((~BCo) & BCu);
+        Ago = BCo ^ ((~BCu) & BCa);
+        Agu = BCu ^ ((~BCa) & BCe);
+
+        Ebe ^= De;
+        BCa = ROL(Ebe, 1);
+        Egi ^= Di;
+        BCe = ROL(Egi, 6);
+        Eko ^= Do;
+        BCi = ROL(Eko, 25);
+        Emu ^= Du;
+        BCo = ROL(Emu, 8);
+        Esa ^= Da;
+        BCu = ROL(Esa, 18);
+        Aka = BCa ^ ((~BCe) & BCi);
+        Ake = BCe ^ ((~BCi) & BCo);
+        Aki = BCi ^ ((~BCo) & BCu);
+        Ako = BCo ^ ((~BCu) & BCa);
+        Aku = BCu ^ ((~BCa) & BCe);
+
+        Ebu ^= Du;
+        BCa = ROL(Ebu, 27);
+        Ega ^= Da;
+        BCe = ROL(Ega, 36);
+        Eke ^= De;
+        BCi = ROL(Eke, 10);
+        Emi ^= Di;
+        BCo = ROL(Emi, 15);
+        Eso ^= Do;
+        BCu = ROL(Eso, 56);
+        Ama = BCa ^ ((~BCe) & BCi);
+        Ame = BCe ^ ((~BCi) & BCo);
+        Ami = BCi ^ ((~BCo) & BCu);
+        Amo = BCo ^ ((~BCu) & BCa);
+        Amu = BCu ^ ((~BCa) & BCe);
+
+        Ebi ^= Di;
+        BCa = ROL(Ebi, 62);
+        Ego ^= Do;
+        BCe = ROL(Ego, 55);
+        Eku ^= Du;
+        BCi = ROL(Eku, 39);
+        Ema ^= Da;
+        BCo = ROL(Ema, 41);
+        Ese ^= De;
+        BCu = ROL(Ese, 2);
+        Asa = BCa ^ ((~BCe) & BCi);
+        Ase = BCe ^ ((~BCi) & BCo);
+        Asi = BCi ^ ((~BCo) & BCu);
+        Aso = BCo ^ ((~BCu) & BCa);
+        Asu = BCu ^ ((~BCa) & BCe);
+    }
+
+    // copyToState(state, A)
+    state[0] = Aba;
+    state[1] = Abe;
+    state[2] = Abi;
+    state[3] = Abo;
+    state[4] = Abu;
+    state[5] = Aga;
+    state[6] = Age;
+    state[7] = Agi;
+    state[8] = Ago;
+    state[9] = Agu;
+    state[10] = Aka;
+    state[11] = Ake;
+    state[12] = Aki;
+    state[13] = Ako;
+    state[14] = Aku;
+    state[15] = Ama;
+    state[16] = Ame;
+    state[17] = Ami;
+    state[18] = Amo;
+    state[19] = Amu;
+    state[20] = Asa;
+    state[21] = Ase;
+    state[22] = Asi;
+    state[23] = Aso;
+    state[24] = Asu;
+}
+
+/*************************************************
+ * Name:        keccak_xor_byte
+ *
+ * Description: XOR one byte into the state
+ *
+ * Arguments:   - uint64_t *s: pointer to input/output Keccak state
+ *              - size_t pos: byte offset into the state
+ *              - uint8_t b: byte to XOR in
+ **************************************************/
+static inline void keccak_xor_byte(uint64_t *s, size_t pos, uint8_t b) {
+    s[pos >> 3] ^= (uint64_t)b << (8 * (pos & 0x07));
+}
+
+/*************************************************
+ * Name:        keccak_get_byte
+ *
+ * Description: Extract one byte from the state
+ *
+ * Arguments:   - const uint64_t *s: pointer to input Keccak state
+ *              - size_t pos: byte offset into the state
+ *
+ * Returns the byte at offset pos
+ **************************************************/
+static inline uint8_t keccak_get_byte(const uint64_t *s, size_t pos) {
+    return (uint8_t)(s[pos >> 3] >> (8 * (pos & 0x07)));
+}
+
+/*************************************************
+ * Name:        keccak_xor_lane
+ *
+ * Description: XOR 8 little-endian bytes into lane i of the state
+ *
+ * Arguments:   - uint64_t *s: pointer to input/output Keccak state
+ *              - size_t i: lane index
+ *              - const uint8_t *x: pointer to 8 input bytes
+ **************************************************/
+static inline void keccak_xor_lane(uint64_t *s, size_t i, const uint8_t *x) {
+    s[i] ^= load64(x);
+}
+
+/*************************************************
+ * Name:        keccak_get_lane
+ *
+ * Description: Store lane i of the state as 8 little-endian bytes
+ *
+ * Arguments:   - uint8_t *x: pointer to 8 output bytes
+ *              - const uint64_t *s: pointer to input Keccak state
+ *              - size_t i: lane index
+ **************************************************/
+static inline void keccak_get_lane(uint8_t *x, const uint64_t *s, size_t i) {
+    store64(x, s[i]);
+}
+
+#endif
+
+/*************************************************
+ * Name:        keccak_absorb
+ *
+ * Description: Absorb step of Keccak;
+ *              non-incremental, starts by zeroeing the state.
+ *
+ * Arguments:   - uint64_t *s: pointer to (uninitialized) output Keccak state
+ *              - uint32_t r: rate in bytes (e.g., 168 for SHAKE128)
+ *              - const uint8_t *m: pointer to input to be absorbed into s
+ *              - size_t mlen: length of input in bytes
+ *              - uint8_t p: domain-separation byte for different
+ *                                 Keccak-derived functions
+ **************************************************/
+static void keccak_absorb(uint64_t *s, uint32_t r, const uint8_t *m,
+                          size_t mlen, uint8_t p) {
+    size_t i;
+    uint8_t t[200];
+
+    /* Zero state */
+    for (i = 0; i < 25; ++i) {
+        s[i] = 0;
+    }
+
+    while (mlen >= r) {
+        for (i = 0; i < r / 8; ++i) {
+            keccak_xor_lane(s, i, m + 8 * i);
+        }
+
+        KeccakF1600_StatePermute(s);
+        mlen -= r;
+        m += r;
+    }
+
+    for (i = 0; i < r; ++i) {
+        t[i] = 0;
+    }
+    for (i = 0; i < mlen; ++i) {
+        t[i] = m[i];
+    }
+    t[i] = p;
+    t[r - 1] |= 128;
+    for (i = 0; i < r / 8; ++i) {
+        keccak_xor_lane(s, i, t + 8 * i);
+    }
+}
+
+/*************************************************
+ * Name:        keccak_squeezeblocks
+ *
+ * Description: Squeeze step of Keccak. Squeezes full blocks of r bytes each.
+ *              Modifies the state. Can be called multiple times to keep
+ *              squeezing, i.e., is incremental.
+ *
+ * Arguments:   - uint8_t *h: pointer to output blocks
+ *              - size_t nblocks: number of blocks to be
+ *                                                squeezed (written to h)
+ *              - uint64_t *s: pointer to input/output Keccak state
+ *              - uint32_t r: rate in bytes (e.g., 168 for SHAKE128)
+ **************************************************/
+static void keccak_squeezeblocks(uint8_t *h, size_t nblocks,
+                                 uint64_t *s, uint32_t r) {
+    while (nblocks > 0) {
+        KeccakF1600_StatePermute(s);
+        for (size_t i = 0; i < (r >> 3); i++) {
+            keccak_get_lane(h + 8 * i, s, i);
+        }
+        h += r;
+        nblocks--;
+    }
+}
+
+/*************************************************
+ * Name:        keccak_inc_init
+ *
+ * Description: Initializes the incremental Keccak state to zero.
+ *
+ * Arguments:   - uint64_t *s_inc: pointer to input/output incremental state
+ *                First 25 values represent Keccak state.
+ *                26th value represents either the number of absorbed bytes
+ *                that have not been permuted, or not-yet-squeezed bytes.
+ **************************************************/
+static void keccak_inc_init(uint64_t *s_inc) {
+    size_t i;
+
+    for (i = 0; i < 25; ++i) {
+        s_inc[i] = 0;
+    }
+    s_inc[25] = 0;
+}
+
+/*************************************************
+ * Name:        keccak_inc_absorb
+ *
+ * Description: Incremental keccak absorb
+ *              Preceded by keccak_inc_init, succeeded by keccak_inc_finalize
+ *
+ * Arguments:   - uint64_t *s_inc: pointer to input/output incremental state
+ *                First 25 values represent Keccak state.
+ *                26th value represents either the number of absorbed bytes
+ *                that have not been permuted, or not-yet-squeezed bytes.
+ *              - uint32_t r: rate in bytes (e.g., 168 for SHAKE128)
+ *              - const uint8_t *m: pointer to input to be absorbed into s
+ *              - size_t mlen: length of input in bytes
+ **************************************************/
+static void keccak_inc_absorb(uint64_t *s_inc, uint32_t r, const uint8_t *m,
+                              size_t mlen) {
+    size_t i;
+
+    /* Recall that s_inc[25] is the non-absorbed bytes xored into the state */
+    while (mlen + s_inc[25] >= r) {
+        for (i = 0; i < r - (uint32_t)s_inc[25]; i++) {
+            /* Take the i'th byte from message
+               xor with the s_inc[25] + i'th byte of the state; little-endian */
+            keccak_xor_byte(s_inc, (size_t)s_inc[25] + i, m[i]);
+        }
+        mlen -= (size_t)(r - s_inc[25]);
+        m += r - s_inc[25];
+        s_inc[25] = 0;
+
+        KeccakF1600_StatePermute(s_inc);
+    }
+
+    for (i = 0; i < mlen; i++) {
+        keccak_xor_byte(s_inc, (size_t)s_inc[25] + i, m[i]);
+    }
+    s_inc[25] += mlen;
+}
+
+/*************************************************
+ * Name:        keccak_inc_finalize
+ *
+ * Description: Finalizes Keccak absorb phase, prepares for squeezing
+ *
+ * Arguments:   - uint64_t *s_inc: pointer to input/output incremental state
+ *                First 25 values represent Keccak state.
+ *                26th value represents either the number of absorbed bytes
+ *                that have not been permuted, or not-yet-squeezed bytes.
+ *              - uint32_t r: rate in bytes (e.g., 168 for SHAKE128)
+ *              - uint8_t p: domain-separation byte for different
+ *                                 Keccak-derived functions
+ **************************************************/
+static void keccak_inc_finalize(uint64_t *s_inc, uint32_t r, uint8_t p) {
+    /* After keccak_inc_absorb, we are guaranteed that s_inc[25] < r,
+       so we can always use one more byte for p in the current state. */
+    keccak_xor_byte(s_inc, (size_t)s_inc[25], p);
+    keccak_xor_byte(s_inc, r - 1, 128);
+    s_inc[25] = 0;
+}
+
+/*************************************************
+ * Name:        keccak_inc_squeeze
+ *
+ * Description: Incremental Keccak squeeze; can be called on byte-level
+ *
+ * Arguments:   - uint8_t *h: pointer to output bytes
+ *              - size_t outlen: number of bytes to be squeezed
+ *              - uint64_t *s_inc: pointer to input/output incremental state
+ *                First 25 values represent Keccak state.
+ *                26th value represents either the number of absorbed bytes
+ *                that have not been permuted, or not-yet-squeezed bytes.
+ *              - uint32_t r: rate in bytes (e.g., 168 for SHAKE128)
+ **************************************************/
+static void keccak_inc_squeeze(uint8_t *h, size_t outlen,
+                               uint64_t *s_inc, uint32_t r) {
+    size_t i;
+
+    /* First consume any bytes we still have sitting around */
+    for (i = 0; i < outlen && i < s_inc[25]; i++) {
+        /* There are s_inc[25] bytes left, so r - s_inc[25] is the first
+           available byte. We consume from there, i.e., up to r. */
+        h[i] = keccak_get_byte(s_inc, (size_t)(r - s_inc[25] + i));
+    }
+    h += i;
+    outlen -= i;
+    s_inc[25] -= i;
+
+    /* Then squeeze the remaining necessary blocks */
+    while (outlen > 0) {
+        KeccakF1600_StatePermute(s_inc);
+
+        for (i = 0; i < outlen && i < r; i++) {
+            h[i] = keccak_get_byte(s_inc, i);
+        }
+        h += i;
+        outlen -= i;
+        s_inc[25] = r - i;
+    }
+}
+
+void shake128_inc_init(shake128incctx *state) {
+    keccak_inc_init(state->ctx);
+}
+
+void shake128_inc_absorb(shake128incctx *state, const uint8_t *input, size_t inlen) {
+    keccak_inc_absorb(state->ctx, SHAKE128_RATE, input, inlen);
+}
+
+void shake128_inc_finalize(shake128incctx *state) {
+    keccak_inc_finalize(state->ctx, SHAKE128_RATE, 0x1F);
+}
+
+void shake128_inc_squeeze(uint8_t *output, size_t outlen, shake128incctx *state) {
+    keccak_inc_squeeze(output, outlen, state->ctx, SHAKE128_RATE);
+}
+
+void shake128_inc_ctx_clone(shake128incctx *dest, const shake128incctx *src) {
+    memcpy(dest->ctx, src->ctx, PQC_SHAKEINCCTX_BYTES);
+}
+
+void shake128_inc_ctx_release(shake128incctx *state) {
+    /* Contexts hold their state inline; nothing to free */
+    (void)state;
+}
+
+void shake256_inc_init(shake256incctx *state) {
+    keccak_inc_init(state->ctx);
+}
+
+void shake256_inc_absorb(shake256incctx *state, const uint8_t *input, size_t inlen) {
+    keccak_inc_absorb(state->ctx, SHAKE256_RATE, input, inlen);
+}
+
+void shake256_inc_finalize(shake256incctx *state) {
+    keccak_inc_finalize(state->ctx, SHAKE256_RATE, 0x1F);
+}
+
+void shake256_inc_squeeze(uint8_t *output, size_t outlen, shake256incctx *state) {
+    keccak_inc_squeeze(output, outlen, state->ctx, SHAKE256_RATE);
+}
+
+void shake256_inc_ctx_clone(shake256incctx *dest, const shake256incctx *src) {
+    memcpy(dest->ctx, src->ctx, PQC_SHAKEINCCTX_BYTES);
+}
+
+void shake256_inc_ctx_release(shake256incctx *state) {
+    /* Contexts hold their state inline; nothing to free */
+    (void)state;
+}
+
+/*************************************************
+ * Name:        shake128_absorb
+ *
+ * Description: Absorb step of the SHAKE128 XOF.
+ *              non-incremental, starts by zeroeing the state.
+ *
+ * Arguments:   - uint64_t *s: pointer to (uninitialized) output Keccak state
+ *              - const uint8_t *input: pointer to input to be absorbed
+ *                                            into s
+ *              - size_t inlen: length of input in bytes
+ **************************************************/
+void shake128_absorb(shake128ctx *state, const uint8_t *input, size_t inlen) {
+    keccak_absorb(state->ctx, SHAKE128_RATE, input, inlen, 0x1F);
+}
+
+/*************************************************
+ * Name:        shake128_squeezeblocks
+ *
+ * Description: Squeeze step of SHAKE128 XOF. Squeezes full blocks of
+ *              SHAKE128_RATE bytes each. Modifies the state. Can be called
+ *              multiple times to keep squeezing, i.e., is incremental.
+ *
+ * Arguments:   - uint8_t *output: pointer to output blocks
+ *              - size_t nblocks: number of blocks to be squeezed
+ *                                            (written to output)
+ *              - shake128ctx *state: pointer to input/output Keccak state
+ **************************************************/
+void shake128_squeezeblocks(uint8_t *output, size_t nblocks, shake128ctx *state) {
+    keccak_squeezeblocks(output, nblocks, state->ctx, SHAKE128_RATE);
+}
+
+void shake128_ctx_clone(shake128ctx *dest, const shake128ctx *src) {
+    memcpy(dest->ctx, src->ctx, PQC_SHAKECTX_BYTES);
+}
+
+/** Release the allocated state. Call only once. */
+void shake128_ctx_release(shake128ctx *state) {
+    /* Contexts hold their state inline; nothing to free */
+    (void)state;
+}
+
+/*************************************************
+ * Name:        shake256_absorb
+ *
+ * Description: Absorb step of the SHAKE256 XOF.
+ *              non-incremental, starts by zeroeing the state.
+ *
+ * Arguments:   - shake256ctx *state: pointer to (uninitialized) output Keccak state
+ *              - const uint8_t *input: pointer to input to be absorbed
+ *                                            into s
+ *              - size_t inlen: length of input in bytes
+ **************************************************/
+void shake256_absorb(shake256ctx *state, const uint8_t *input, size_t inlen) {
+    keccak_absorb(state->ctx, SHAKE256_RATE, input, inlen, 0x1F);
+}
+
+/*************************************************
+ * Name:        shake256_squeezeblocks
+ *
+ * Description: Squeeze step of SHAKE256 XOF. Squeezes full blocks of
+ *              SHAKE256_RATE bytes each. Modifies the state. Can be called
+ *              multiple times to keep squeezing, i.e., is incremental.
+ *
+ * Arguments:   - uint8_t *output: pointer to output blocks
+ *              - size_t nblocks: number of blocks to be squeezed
+ *                                (written to output)
+ *              - shake256ctx *state: pointer to input/output Keccak state
+ **************************************************/
+void shake256_squeezeblocks(uint8_t *output, size_t nblocks, shake256ctx *state) {
+    keccak_squeezeblocks(output, nblocks, state->ctx, SHAKE256_RATE);
+}
+
+void shake256_ctx_clone(shake256ctx *dest, const shake256ctx *src) {
+    memcpy(dest->ctx, src->ctx, PQC_SHAKECTX_BYTES);
+}
+
+/** Release the allocated state. Call only once. */
+void shake256_ctx_release(shake256ctx *state) {
+    /* Contexts hold their state inline; nothing to free */
+    (void)state;
+}
+
+/*************************************************
+ * Name:        shake128
+ *
+ * Description: SHAKE128 XOF with non-incremental API
+ *
+ * Arguments:   - uint8_t *output: pointer to output
+ *              - size_t outlen: requested output length in bytes
+ *              - const uint8_t *input: pointer to input
+ *              - size_t inlen: length of input in bytes
+ **************************************************/
+void shake128(uint8_t *output, size_t outlen,
+              const uint8_t *input, size_t inlen) {
+    size_t nblocks = outlen / SHAKE128_RATE;
+    uint8_t t[SHAKE128_RATE];
+    shake128ctx s;
+
+    shake128_absorb(&s, input, inlen);
+    shake128_squeezeblocks(output, nblocks, &s);
+
+    output += nblocks * SHAKE128_RATE;
+    outlen -= nblocks * SHAKE128_RATE;
+
+    if (outlen) {
+        shake128_squeezeblocks(t, 1, &s);
+        for (size_t i = 0; i < outlen; ++i) {
+            output[i] = t[i];
+        }
+    }
+    shake128_ctx_release(&s);
+}
+
+/*************************************************
+ * Name:        shake256
+ *
+ * Description: SHAKE256 XOF with non-incremental API
+ *
+ * Arguments:   - uint8_t *output: pointer to output
+ *              - size_t outlen: requested output length in bytes
+ *              - const uint8_t *input: pointer to input
+ *              - size_t inlen: length of input in bytes
+ **************************************************/
+void shake256(uint8_t *output, size_t outlen,
+              const uint8_t *input, size_t inlen) {
+    size_t nblocks = outlen / SHAKE256_RATE;
+    uint8_t t[SHAKE256_RATE];
+    shake256ctx s;
+
+    shake256_absorb(&s, input, inlen);
+    shake256_squeezeblocks(output, nblocks, &s);
+
+    output += nblocks * SHAKE256_RATE;
+    outlen -= nblocks * SHAKE256_RATE;
+
+    if (outlen) {
+        shake256_squeezeblocks(t, 1, &s);
+        for (size_t i = 0; i < outlen; ++i) {
+            output[i] = t[i];
+        }
+    }
+    shake256_ctx_release(&s);
+}
+
+void sha3_256_inc_init(sha3_256incctx *state) {
+    keccak_inc_init(state->ctx);
+}
+
+void sha3_256_inc_ctx_clone(sha3_256incctx *dest, const sha3_256incctx *src) {
+    memcpy(dest->ctx, src->ctx, PQC_SHAKEINCCTX_BYTES);
+}
+
+void sha3_256_inc_ctx_release(sha3_256incctx *state) {
+    /* Contexts hold their state inline; nothing to free */
+    (void)state;
+}
+
+void sha3_256_inc_absorb(sha3_256incctx *state, const uint8_t *input, size_t inlen) {
+    keccak_inc_absorb(state->ctx, SHA3_256_RATE, input, inlen);
+}
+
+void sha3_256_inc_finalize(uint8_t *output, sha3_256incctx *state) {
+    uint8_t t[SHA3_256_RATE];
+    keccak_inc_finalize(state->ctx, SHA3_256_RATE, 0x06);
+
+    keccak_squeezeblocks(t, 1, state->ctx, SHA3_256_RATE);
+
+    sha3_256_inc_ctx_release(state);
+
+    for (size_t i = 0; i < 32; i++) {
+        output[i] = t[i];
+    }
+}
+
+/*************************************************
+ * Name:        sha3_256
+ *
+ * Description: SHA3-256 with non-incremental API
+ *
+ * Arguments:   - uint8_t *output:      pointer to output
+ *              - const uint8_t *input: pointer to input
+ *              - size_t inlen:   length of input in bytes
+ **************************************************/
+void sha3_256(uint8_t *output, const uint8_t *input, size_t inlen) {
+    uint64_t s[25];
+    uint8_t t[SHA3_256_RATE];
+
+    /* Absorb input */
+    keccak_absorb(s, SHA3_256_RATE, input, inlen, 0x06);
+
+    /* Squeeze output */
+    keccak_squeezeblocks(t, 1, s, SHA3_256_RATE);
+
+    for (size_t i = 0; i < 32; i++) {
+        output[i] = t[i];
+    }
+}
+
+void sha3_384_inc_init(sha3_384incctx *state) {
+    keccak_inc_init(state->ctx);
+}
+
+void sha3_384_inc_ctx_clone(sha3_384incctx *dest, const sha3_384incctx *src) {
+    memcpy(dest->ctx, src->ctx, PQC_SHAKEINCCTX_BYTES);
+}
+
+void sha3_384_inc_absorb(sha3_384incctx *state, const uint8_t *input, size_t inlen) {
+    keccak_inc_absorb(state->ctx, SHA3_384_RATE, input, inlen);
+}
+
+void sha3_384_inc_ctx_release(sha3_384incctx *state) {
+    /* Contexts hold their state inline; nothing to free */
+    (void)state;
+}
+
+void sha3_384_inc_finalize(uint8_t *output, sha3_384incctx *state) {
+    uint8_t t[SHA3_384_RATE];
+    keccak_inc_finalize(state->ctx, SHA3_384_RATE, 0x06);
+
+    keccak_squeezeblocks(t, 1, state->ctx, SHA3_384_RATE);
+
+    sha3_384_inc_ctx_release(state);
+
+    for (size_t i = 0; i < 48; i++) {
+        output[i] = t[i];
+    }
+}
+
+/*************************************************
+ * Name:        sha3_384
+ *
+ * Description: SHA3-256 with non-incremental API
+ *
+ * Arguments:   - uint8_t *output:      pointer to output
+ *              - const uint8_t *input: pointer to input
+ *              - size_t inlen:   length of input in bytes
+ **************************************************/
+void sha3_384(uint8_t *output, const uint8_t *input, size_t inlen) {
+    uint64_t s[25];
+    uint8_t t[SHA3_384_RATE];
+
+    /* Absorb input */
+    keccak_absorb(s, SHA3_384_RATE, input, inlen, 0x06);
+
+    /* Squeeze output */
+    keccak_squeezeblocks(t, 1, s, SHA3_384_RATE);
+
+    for (size_t i = 0; i < 48; i++) {
+        output[i] = t[i];
+    }
+}
+
+void sha3_512_inc_init(sha3_512incctx *state) {
+    keccak_inc_init(state->ctx);
+}
+
+void sha3_512_inc_ctx_clone(sha3_512incctx *dest, const sha3_512incctx *src) {
+    memcpy(dest->ctx, src->ctx, PQC_SHAKEINCCTX_BYTES);
+}
+
+void sha3_512_inc_absorb(sha3_512incctx *state, const uint8_t *input, size_t inlen) {
+    keccak_inc_absorb(state->ctx, SHA3_512_RATE, input, inlen);
+}
+
+void sha3_512_inc_ctx_release(sha3_512incctx *state) {
+    /* Contexts hold their state inline; nothing to free */
+    (void)state;
+}
+
+void sha3_512_inc_finalize(uint8_t *output, sha3_512incctx *state) {
+    uint8_t t[SHA3_512_RATE];
+    keccak_inc_finalize(state->ctx, SHA3_512_RATE, 0x06);
+
+    keccak_squeezeblocks(t, 1, state->ctx, SHA3_512_RATE);
+
+    sha3_512_inc_ctx_release(state);
+
+    for (size_t i = 0; i < 64; i++) {
+        output[i] = t[i];
+    }
+}
+
+/*************************************************
+ * Name:        sha3_512
+ *
+ * Description: SHA3-512 with non-incremental API
+ *
+ * Arguments:   - uint8_t *output:      pointer to output
+ *              - const uint8_t *input: pointer to input
+ *              - size_t inlen:   length of input in bytes
+ **************************************************/
+void sha3_512(uint8_t *output, const uint8_t *input, size_t inlen) {
+    uint64_t s[25];
+    uint8_t t[SHA3_512_RATE];
+
+    /* Absorb input */
+    keccak_absorb(s, SHA3_512_RATE, input, inlen, 0x06);
+
+    /* Squeeze output */
+    keccak_squeezeblocks(t, 1, s, SHA3_512_RATE);
+
+    for (size_t i = 0; i < 64; i++) {
+        output[i] = t[i];
+    }
+}
+
+/* 4-way API backend selection.
+ * 0: the four states are permuted one after the other with the single-state
+ *    permutation above; lanes that are no longer needed are skipped.
+ * 1: the four states are stored lane by lane and permuted together with
+ *    GCC vector extensions, which map onto SSE2/AVX2 or NEON on a host
+ *    build. Needs the 64-bit lane backend. */
+#ifndef PQC_KECCAK_X4_SIMD
+#if !PQC_KECCAK_BI32 && defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON))
+#define PQC_KECCAK_X4_SIMD 1
+#else
+#define PQC_KECCAK_X4_SIMD 0
+#endif
+#endif
+
+#if PQC_KECCAK_X4_SIMD
+#if PQC_KECCAK_BI32
+#error "PQC_KECCAK_X4_SIMD requires PQC_KECCAK_BI32=0"
+#endif
+
+typedef uint64_t v4u64 __attribute__((vector_size(32), aligned(8)));
+
+/*************************************************
+ * Name:        KeccakF1600_StatePermute4x
+ *
+ * Description: The Keccak F1600 Permutation on four states at once
+ *
+ * Arguments:   - v4u64 *state: pointer to input/output lane-major state
+ **************************************************/
+static void KeccakF1600_StatePermute4x(v4u64 *state) {
+    int round;
+
+    v4u64 Aba, Abe, Abi, Abo, Abu;
+    v4u64 Aga, Age, Agi, Ago, Agu;
+    v4u64 Aka, Ake, Aki, Ako, Aku;
+    v4u64 Ama, Ame, Ami, Amo, Amu;
+    v4u64 Asa, Ase, Asi, Aso, Asu;
+    v4u64 BCa, BCe, BCi, BCo, BCu;
+    v4u64 Da, De, Di, Do, Du;
+    v4u64 Eba, Ebe, Ebi, Ebo, Ebu;
+    v4u64 Ega, Ege, Egi, Ego, Egu;
+    v4u64 Eka, Eke, Eki, Eko, Eku;
+    v4u64 Ema, Eme, Emi, Emo, Emu;
+    v4u64 Esa, Ese, Esi, Eso, Esu;
+
+    // copyFromState(A, state)
+    Aba = state[0];
+    Abe = state[1];
+    Abi = state[2];
+    Abo = state[3];
+    Abu = state[4];
+    Aga = state[5];
+    Age = state[6];
+    Agi = state[7];
+    Ago = state[8];
+    Agu = state[9];
+    Aka = state[10];
+    Ake = state[11];
+    Aki = state[12];
+    Ako = state[13];
+    Aku = state[14];
+    Ama = state[15];
+    Ame = state[16];
+    Ami = state[17];
+    Amo = state[18];
+    Amu = state[19];
+    Asa = state[20];
+    Ase = state[21];
+    Asi = state[22];
+    Aso = state[23];
+    Asu = state[24];
+
+    for (round = 0; round < NROUNDS; round += 2) {
+        //    prepareTheta
+        BCa = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+        BCe = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+        BCi = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+        BCo = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+        BCu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+
+        // thetaRhoPiChiIotaPrepareTheta(round  , A, E)
+        Da = BCu ^ ROL(BCe, 1);
+        De = BCa ^ ROL(BCi, 1);
+        Di = BCe ^ ROL(BCo, 1);
+        Do = BCi ^ ROL(BCu, 1);
+        Du = BCo ^ ROL(BCa, 1);
+
+        Aba ^= Da;
+        BCa = Aba;
+        Age ^= De;
+        BCe = ROL(Age, 44);
+        Aki ^= Di;
+        BCi = ROL(Aki, 43);
+        Amo ^= Do;
+        BCo = ROL(Amo, 21);
+        Asu ^= Du;
+        BCu = ROL(Asu, 14);
+        Eba = BCa ^ ((~BCe) & BCi);
+        Eba ^= KeccakF_RoundConstants[round];
+        Ebe = BCe ^ ((~BCi) & BCo);
+        Ebi = BCi ^ ((~BCo) & BCu);
+        Ebo = BCo ^ ((~BCu) & BCa);
+        Ebu = BCu ^ ((~BCa) & BCe);
+
+        Abo ^= Do;
+        BCa = ROL(Abo, 28);
+        Agu ^= Du;
+        BCe = ROL(Agu, 20);
+        Aka ^= Da;
+        BCi = ROL(Aka, 3);
+        Ame ^= De;
+        BCo = ROL(Ame, 45);
+        Asi ^= Di;
+        BCu = ROL(Asi, 61);
+        Ega = BCa ^ ((~BCe) & BCi);
+        Ege = BCe ^ ((~BCi) & BCo);
+        Egi = BCi ^ ((~BCo) & BCu);
+        Ego = BCo ^ ((~BCu) & BCa);
+        Egu = BCu ^ ((~BCa) & BCe);
+
+        Abe ^= De;
+        BCa = ROL(Abe, 1);
+        Agi ^= Di;
+        BCe = ROL(Agi, 6);
+        Ako ^= Do;
+        BCi = ROL(Ako, 25);
+        Amu ^= Du;
+        BCo = ROL(Amu, 8);
+        Asa ^= Da;
+        BCu = ROL(Asa, 18);
+        Eka = BCa ^ ((~BCe) & BCi);
+        Eke = BCe ^ ((~BCi) & BCo);
+        Eki = BCi ^ ((~BCo) & BCu);
+        Eko = BCo ^ ((~BCu) & BCa);
+        Eku = BCu ^ ((~BCa) & BCe);
+
+        Abu ^= Du;
+        BCa = ROL(Abu, 27);
+        Aga ^= Da;
+        BCe = ROL(Aga, 36);
+        Ake ^= De;
+        BCi = ROL(Ake, 10);
+        Ami ^= Di;
+        BCo = ROL(Ami, 15);
+        Aso ^= Do;
+        BCu = ROL(Aso, 56);
+        Ema = BCa ^ ((~BCe) & BCi);
+        Eme = BCe ^ ((~BCi) & BCo);
+        Emi = BCi ^ ((~BCo) & BCu);
+        Emo = BCo ^ ((~BCu) & BCa);
+        Emu = BCu ^ ((~BCa) & BCe);
+
+        Abi ^= Di;
+        BCa = ROL(Abi, 62);
+        Ago ^= Do;
+        BCe = ROL(Ago, 55);
+        Aku ^= Du;
+        BCi = ROL(Aku, 39);
+        Ama ^= Da;
+        BCo = ROL(Ama, 41);
+        Ase ^= De;
+        BCu = ROL(Ase, 2);
+        Esa = BCa ^ ((~BCe) & BCi);
+        Ese = BCe ^ ((~BCi) & BCo);
+        Esi = BCi ^ ((~BCo) & BCu);
+        Eso = BCo ^ ((~BCu) & BCa);
+        Esu = BCu ^ ((~BCa) & BCe);
+
+        //    prepareTheta
+        BCa = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+        BCe = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+        BCi = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+        BCo = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+        BCu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+
+        // thetaRhoPiChiIotaPrepareTheta(round+1, E, A)
+        Da = BCu ^ ROL(BCe, 1);
+        De = BCa ^ ROL(BCi, 1);
+        Di = BCe ^ ROL(BCo, 1);
+        Do = BCi ^ ROL(BCu, 1);
+        Du = BCo ^ ROL(BCa, 1);
+
+        Eba ^= Da;
+        BCa = Eba;
+        Ege ^= De;
+        BCe = ROL(Ege, 44);
+        Eki ^= Di;
+        BCi = ROL(Eki, 43);
+        Emo ^= Do;
+        BCo = ROL(Emo, 21);
+        Esu ^= Du;
+        BCu = ROL(Esu, 14);
+        Aba = BCa ^ ((~BCe) & BCi);
+        Aba ^= KeccakF_RoundConstants[round + 1];
+        Abe = BCe ^ ((~BCi) & BCo);
+        Abi = BCi ^ ((~BCo) & BCu);
+        Abo = BCo ^ ((~BCu) & BCa);
+        Abu = BCu ^ ((~BCa) & BCe);
+
+        Ebo ^= Do;
+        BCa = ROL(Ebo, 28);
+        Egu ^= Du;
+        BCe = ROL(Egu, 20);
+        Eka ^= Da;
+        BCi = ROL(Eka, 3);
+        Eme ^= De;
+        BCo = ROL(Eme, 45);
+        Esi ^= Di;
+        BCu = ROL(Esi, 61);
+        Aga = BCa ^ ((~BCe) & BCi);
+        Age = BCe ^ ((~BCi) & BCo);
+        Agi = BCi ^ ((~BCo) & BCu);
+        Ago = BCo ^ ((~BCu) & BCa);
+        Agu = BCu ^ ((~BCa) & BCe);
+
+        Ebe ^= De;
+        BCa = ROL(Ebe, 1);
+        Egi ^= Di;
+        BCe = ROL(Egi, 6);
+        Eko ^= Do;
+        BCi = ROL(Eko, 25);
+        Emu ^= Du;
+        BCo = ROL(Emu, 8);
+        Esa ^= Da;
+        BCu = ROL(Esa, 18);
+        Aka = BCa ^ ((~BCe) & BCi);
+        Ake = BCe ^ ((~BCi) & BCo);
+        Aki = BCi ^ ((~BCo) & BCu);
+        Ako = BCo ^ ((~BCu) & BCa);
+        Aku = BCu ^ ((~BCa) & BCe);
+
+        Ebu ^= Du;
+        BCa = ROL(Ebu, 27);
+        Ega ^= Da;
+        BCe = ROL(Ega, 36);
+        Eke ^= De;
+        BCi = ROL(Eke, 10);
+        Emi ^= Di;
+        BCo = ROL(Emi, 15);
+        Eso ^= Do;
+        BCu = ROL(Eso, 56);
+        Ama = BCa ^ ((~BCe) & BCi);
+        Ame = BCe ^ ((~BCi) & BCo);
+        Ami = BCi ^ ((~BCo) & BCu);
+        Amo = BCo ^ ((~BCu) & BCa);
+        Amu = BCu ^ ((~BCa) & BCe);
+
+        Ebi ^= Di;
+        BCa = ROL(Ebi, 62);
+        Ego ^= Do;
+        BCe = ROL(Ego, 55);
+        Eku ^= Du;
+        BCi = ROL(Eku, 39);
+        Ema ^= Da;
+        BCo = ROL(Ema, 41);
+        Ese ^= De;
+        BCu = ROL(Ese, 2);
+        Asa = BCa ^ ((~BCe) & BCi);
+        Ase = BCe ^ ((~BCi) & BCo);
+        Asi = BCi ^ ((~BCo) & BCu);
+        Aso = BCo ^ ((~BCu) & BCa);
+        Asu = BCu ^ ((~BCa) & BCe);
+    }
+
+    // copyToState(state, A)
+    state[0] = Aba;
+    state[1] = Abe;
+    state[2] = Abi;
+    state[3] = Abo;
+    state[4] = Abu;
+    state[5] = Aga;
+    state[6] = Age;
+    state[7] = Agi;
+    state[8] = Ago;
+    state[9] = Agu;
+    state[10] = Aka;
+    state[11] = Ake;
+    state[12] = Aki;
+    state[13] = Ako;
+    state[14] = Aku;
+    state[15] = Ama;
+    state[16] = Ame;
+    state[17] = Ami;
+    state[18] = Amo;
+    state[19] = Amu;
+    state[20] = Asa;
+    state[21] = Ase;
+    state[22] = Asi;
+    state[23] = Aso;
+    state[24] = Asu;
+}
+
+static void keccakx4_permute(keccakx4_state *state) {
+    KeccakF1600_StatePermute4x((v4u64 *)state->s);
+}
+
+static void keccakx4_xor_lane(keccakx4_state *state, unsigned int j, size_t i, const uint8_t *x) {
+    state->s[4 * i + j] ^= load64(x);
+}
+
+static void keccakx4_get_lane(uint8_t *x, const keccakx4_state *state, unsigned int j, size_t i) {
+    store64(x, state->s[4 * i + j]);
+}
+
+#else
+
+static void keccakx4_permute(keccakx4_state *state) {
+    for (unsigned int j = 0; j < 4; j++) {
+        if (state->active & (1u << j)) {
+            KeccakF1600_StatePermute(state->s + 25 * j);
+        }
+    }
+}
+
+static void keccakx4_xor_lane(keccakx4_state *state, unsigned int j, size_t i, const uint8_t *x) {
+    keccak_xor_lane(state->s + 25 * j, i, x);
+}
+
+static void keccakx4_get_lane(uint8_t *x, const keccakx4_state *state, unsigned int j, size_t i) {
+    keccak_get_lane(x, state->s + 25 * j, i);
+}
+
+#endif
+
+/*************************************************
+ * Name:        keccakx4_absorb_once
+ *
+ * Description: Absorb step of four independent Keccak instances with
+ *              equal-length inputs; starts by zeroeing the state.
+ *
+ * Arguments:   - keccakx4_state *state: pointer to output state
+ *              - uint32_t r: rate in bytes (e.g., 168 for SHAKE128)
+ *              - const uint8_t *const in[4]: inputs, NULL for unused lanes
+ *              - size_t inlen: length of each input in bytes
+ *              - uint8_t p: domain-separation byte for different
+ *                                 Keccak-derived functions
+ **************************************************/
+static void keccakx4_absorb_once(keccakx4_state *state, uint32_t r,
+                                 const uint8_t *const in[4], size_t inlen, uint8_t p) {
+    size_t i, pos = 0;
+    unsigned int j;
+    uint8_t t[200];
+
+    memset(state->s, 0, sizeof(state->s));
+    state->active = 0;
+    for (j = 0; j < 4; j++) {
+        if (in[j] != NULL) {
+            state->active |= 1u << j;
+        }
+    }
+
+    while (inlen - pos >= r) {
+        for (j = 0; j < 4; j++) {
+            if (in[j] != NULL) {
+                for (i = 0; i < r / 8; ++i) {
+                    keccakx4_xor_lane(state, j, i, in[j] + pos + 8 * i);
+                }
+            }
+        }
+        keccakx4_permute(state);
+        pos += r;
+    }
+
+    for (j = 0; j < 4; j++) {
+        if (in[j] == NULL) {
+            continue;
+        }
+        memset(t, 0, r);
+        memcpy(t, in[j] + pos, inlen - pos);
+        t[inlen - pos] = p;
+        t[r - 1] |= 128;
+        for (i = 0; i < r / 8; ++i) {
+            keccakx4_xor_lane(state, j, i, t + 8 * i);
+        }
+    }
+}
+
+/*************************************************
+ * Name:        keccakx4_squeezeblocks
+ *
+ * Description: Squeeze step of four Keccak instances. Squeezes full blocks
+ *              of r bytes each into every non-NULL output. A lane whose
+ *              output is NULL is dropped and must not be squeezed again.
+ *
+ * Arguments:   - uint8_t *out[4]: output blocks, NULL to drop a lane
+ *              - size_t nblocks: number of blocks per lane
+ *              - keccakx4_state *state: pointer to input/output state
+ *              - uint32_t r: rate in bytes (e.g., 168 for SHAKE128)
+ **************************************************/
+static void keccakx4_squeezeblocks(uint8_t *out[4], size_t nblocks,
+                                   keccakx4_state *state, uint32_t r) {
+    size_t i;
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        if (out[j] == NULL) {
+            state->active &= ~(1u << j);
+        }
+    }
+
+    while (nblocks > 0) {
+        keccakx4_permute(state);
+        for (j = 0; j < 4; j++) {
+            if (out[j] != NULL) {
+                for (i = 0; i < r / 8; i++) {
+                    keccakx4_get_lane(out[j] + 8 * i, state, j, i);
+                }
+                out[j] += r;
+            }
+        }
+        nblocks--;
+    }
+}
+
+void shake128x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0, const uint8_t *in1,
+                            const uint8_t *in2, const uint8_t *in3, size_t inlen) {
+    const uint8_t *const in[4] = {in0, in1, in2, in3};
+    keccakx4_absorb_once(state, SHAKE128_RATE, in, inlen, 0x1F);
+}
+
+void shake128x4_squeezeblocks(uint8_t *out0, uint8_t *out1,
+                              uint8_t *out2, uint8_t *out3,
+                              size_t nblocks, keccakx4_state *state) {
+    uint8_t *out[4] = {out0, out1, out2, out3};
+    keccakx4_squeezeblocks(out, nblocks, state, SHAKE128_RATE);
+}
+
+void shake256x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0, const uint8_t *in1,
+                            const uint8_t *in2, const uint8_t *in3, size_t inlen) {
+    const uint8_t *const in[4] = {in0, in1, in2, in3};
+    keccakx4_absorb_once(state, SHAKE256_RATE, in, inlen, 0x1F);
+}
+
+void shake256x4_squeezeblocks(uint8_t *out0, uint8_t *out1,
+                              uint8_t *out2, uint8_t *out3,
+                              size_t nblocks, keccakx4_state *state) {
+    uint8_t *out[4] = {out0, out1, out2, out3};
+    keccakx4_squeezeblocks(out, nblocks, state, SHAKE256_RATE);
+}
+
+/*************************************************
+ * Name:        fips202_kat
+ *
+ * Description: Known-answer test of the selected Keccak backend against
+ *              reference SHAKE128, SHAKE256 and SHA3-256 outputs. Covers
+ *              multi-block absorption, squeezing past the first block,
+ *              the incremental API with unaligned split points and the
+ *              4-way API.
+ *
+ * Returns 0 on success, -1 on mismatch
+ **************************************************/
+int fips202_kat(void) {
+    static const uint8_t shake128_exp[32] = {
+        0xb0, 0xf1, 0x2f, 0x48, 0xd7, 0xac, 0x9d, 0x17,
+        0x1f, 0x12, 0x05, 0x07, 0x6e, 0x65, 0x04, 0xa5,
+        0x4b, 0x67, 0xf6, 0x84, 0xbf, 0x97, 0x21, 0x7b,
+        0xba, 0x64, 0x83, 0x0d, 0x8c, 0x5e, 0x81, 0x21
+    };
+    /* Bytes 136..167 of SHAKE256(m), i.e. from the second squeezed block */
+    static const uint8_t shake256_exp[32] = {
+        0xa2, 0xed, 0x29, 0xca, 0x55, 0x45, 0x2b, 0x7b,
+        0x59, 0xb8, 0x7b, 0xd3, 0x54, 0x93, 0xeb, 0xc6,
+        0xae, 0xff, 0xfa, 0x51, 0xd1, 0x4b, 0xef, 0xda,
+        0x5b, 0x0b, 0x81, 0xce, 0xcc, 0xda, 0x12, 0xae
+    };
+    static const uint8_t sha3_256_exp[32] = {
+        0x1b, 0xea, 0x1a, 0x85, 0xc8, 0x2f, 0x14, 0x1d,
+        0x11, 0x89, 0x88, 0xbe, 0x6f, 0x7a, 0x7c, 0x08,
+        0x75, 0xa4, 0x5c, 0x1a, 0x98, 0x20, 0xf2, 0xe1,
+        0xd7, 0x79, 0x70, 0x61, 0xd2, 0xb3, 0xd8, 0x6a
+    };
+    /* Bytes 168..199 of SHAKE256(m[0..32]) */
+    static const uint8_t shake256_inc_exp[32] = {
+        0xfa, 0x87, 0x26, 0x78, 0x6c, 0x73, 0x95, 0x98,
+        0x04, 0xf3, 0xe1, 0x14, 0x19, 0x50, 0x63, 0x6a,
+        0xb1, 0x0c, 0xeb, 0x68, 0xce, 0xce, 0xde, 0x01,
+        0x18, 0x4e, 0xa1, 0x0a, 0x1d, 0x39, 0x7a, 0x5a
+    };
+    uint8_t m[200];
+    uint8_t out[2 * SHAKE256_RATE];
+    uint8_t lane[2][2 * SHAKE256_RATE];
+    shake256incctx state;
+    keccakx4_state state4;
+    int ret = 0;
+
+    for (size_t i = 0; i < sizeof(m); i++) {
+        m[i] = (uint8_t)(7 * i + 1);
+    }
+
+    shake128(out, 32, m, sizeof(m));
+    ret |= memcmp(out, shake128_exp, 32);
+
+    shake256(out, SHAKE256_RATE + 32, m, sizeof(m));
+    ret |= memcmp(out + SHAKE256_RATE, shake256_exp, 32);
+
+    sha3_256(out, m, sizeof(m));
+    ret |= memcmp(out, sha3_256_exp, 32);
+
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, m, 1);
+    shake256_inc_absorb(&state, m + 1, 32);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(out, 5, &state);
+    shake256_inc_squeeze(out + 5, 163, &state);
+    shake256_inc_squeeze(out + 168, 32, &state);
+    shake256_inc_ctx_release(&state);
+    ret |= memcmp(out + 168, shake256_inc_exp, 32);
+
+    /* 4-way API against the single-lane one, with unused lanes */
+    shake256x4_absorb_once(&state4, m, NULL, m + 2, NULL, 150);
+    shake256x4_squeezeblocks(lane[0], NULL, lane[1], NULL, 2, &state4);
+    shake256(out, sizeof(out), m, 150);
+    ret |= memcmp(out, lane[0], sizeof(out));
+    shake256(out, sizeof(out), m + 2, 150);
+    ret |= memcmp(out, lane[1], sizeof(out));
+
+    return ret ? -1 : 0;
+}
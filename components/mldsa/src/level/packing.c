@@ -5,7 +5,7 @@
 
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_pack_pk
+* Name:        pack_pk
 *
 * Description: Bit-pack public key pk = (rho, t1).
 *
@@ -13,9 +13,9 @@
 *              - const uint8_t rho[]: byte array containing rho
 *              - const polyveck *t1: pointer to vector t1
 **************************************************/
-void PQCLEAN_MLDSA44_CLEAN_pack_pk(uint8_t pk[PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES],
-                                   const uint8_t rho[SEEDBYTES],
-                                   const polyveck *t1) {
+void MLDSA_NAMESPACE(pack_pk)(uint8_t pk[CRYPTO_PUBLICKEYBYTES],
+                              const uint8_t rho[SEEDBYTES],
+                              const polyveck *t1) {
     unsigned int i;
 
     for (i = 0; i < SEEDBYTES; ++i) {
@@ -24,12 +24,12 @@ void PQCLEAN_MLDSA44_CLEAN_pack_pk(uint8_t pk[PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLI
     pk += SEEDBYTES;
 
     for (i = 0; i < K; ++i) {
-        PQCLEAN_MLDSA44_CLEAN_polyt1_pack(pk + i * POLYT1_PACKEDBYTES, &t1->vec[i]);
+        PQCLEAN_MLDSA_CLEAN_polyt1_pack(pk + i * POLYT1_PACKEDBYTES, &t1->vec[i]);
     }
 }
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_unpack_pk
+* Name:        unpack_pk
 *
 * Description: Unpack public key pk = (rho, t1).
 *
@@ -37,9 +37,9 @@ void PQCLEAN_MLDSA44_CLEAN_pack_pk(uint8_t pk[PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLI
 *              - const polyveck *t1: pointer to output vector t1
 *              - uint8_t pk[]: byte array containing bit-packed pk
 **************************************************/
-void PQCLEAN_MLDSA44_CLEAN_unpack_pk(uint8_t rho[SEEDBYTES],
-                                     polyveck *t1,
-                                     const uint8_t pk[PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES]) {
+void MLDSA_NAMESPACE(unpack_pk)(uint8_t rho[SEEDBYTES],
+                                polyveck *t1,
+                                const uint8_t pk[CRYPTO_PUBLICKEYBYTES]) {
     unsigned int i;
 
     for (i = 0; i < SEEDBYTES; ++i) {
@@ -48,12 +48,12 @@ void PQCLEAN_MLDSA44_CLEAN_unpack_pk(uint8_t rho[SEEDBYTES],
     pk += SEEDBYTES;
 
     for (i = 0; i < K; ++i) {
-        PQCLEAN_MLDSA44_CLEAN_polyt1_unpack(&t1->vec[i], pk + i * POLYT1_PACKEDBYTES);
+        PQCLEAN_MLDSA_CLEAN_polyt1_unpack(&t1->vec[i], pk + i * POLYT1_PACKEDBYTES);
     }
 }
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_pack_sk
+* Name:        pack_sk
 *
 * Description: Bit-pack secret key sk = (rho, tr, key, t0, s1, s2).
 *
@@ -65,13 +65,13 @@ void PQCLEAN_MLDSA44_CLEAN_unpack_pk(uint8_t rho[SEEDBYTES],
 *              - const polyvecl *s1: pointer to vector s1
 *              - const polyveck *s2: pointer to vector s2
 **************************************************/
-void PQCLEAN_MLDSA44_CLEAN_pack_sk(uint8_t sk[PQCLEAN_MLDSA44_CLEAN_CRYPTO_SECRETKEYBYTES],
-                                   const uint8_t rho[SEEDBYTES],
-                                   const uint8_t tr[TRBYTES],
-                                   const uint8_t key[SEEDBYTES],
-                                   const polyveck *t0,
-                                   const polyvecl *s1,
-                                   const polyveck *s2) {
+void MLDSA_NAMESPACE(pack_sk)(uint8_t sk[CRYPTO_SECRETKEYBYTES],
+                              const uint8_t rho[SEEDBYTES],
+                              const uint8_t tr[TRBYTES],
+                              const uint8_t key[SEEDBYTES],
+                              const polyveck *t0,
+                              const polyvecl *s1,
+                              const polyveck *s2) {
     unsigned int i;
 
     for (i = 0; i < SEEDBYTES; ++i) {
@@ -90,22 +90,22 @@ void PQCLEAN_MLDSA44_CLEAN_pack_sk(uint8_t sk[PQCLEAN_MLDSA44_CLEAN_CRYPTO_SECRE
     sk += TRBYTES;
 
     for (i = 0; i < L; ++i) {
-        PQCLEAN_MLDSA44_CLEAN_polyeta_pack(sk + i * POLYETA_PACKEDBYTES, &s1->vec[i]);
+        MLDSA_NAMESPACE(polyeta_pack)(sk + i * POLYETA_PACKEDBYTES, &s1->vec[i]);
     }
     sk += L * POLYETA_PACKEDBYTES;
 
     for (i = 0; i < K; ++i) {
-        PQCLEAN_MLDSA44_CLEAN_polyeta_pack(sk + i * POLYETA_PACKEDBYTES, &s2->vec[i]);
+        MLDSA_NAMESPACE(polyeta_pack)(sk + i * POLYETA_PACKEDBYTES, &s2->vec[i]);
     }
     sk += K * POLYETA_PACKEDBYTES;
 
     for (i = 0; i < K; ++i) {
-        PQCLEAN_MLDSA44_CLEAN_polyt0_pack(sk + i * POLYT0_PACKEDBYTES, &t0->vec[i]);
+        PQCLEAN_MLDSA_CLEAN_polyt0_pack(sk + i * POLYT0_PACKEDBYTES, &t0->vec[i]);
     }
 }
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_unpack_sk
+* Name:        unpack_sk
 *
 * Description: Unpack secret key sk = (rho, tr, key, t0, s1, s2).
 *
@@ -117,13 +117,13 @@ void PQCLEAN_MLDSA44_CLEAN_pack_sk(uint8_t sk[PQCLEAN_MLDSA44_CLEAN_CRYPTO_SECRE
 *              - const polyveck *s2: pointer to output vector s2
 *              - uint8_t sk[]: byte array containing bit-packed sk
 **************************************************/
-void PQCLEAN_MLDSA44_CLEAN_unpack_sk(uint8_t rho[SEEDBYTES],
-                                     uint8_t tr[TRBYTES],
-                                     uint8_t key[SEEDBYTES],
-                                     polyveck *t0,
-                                     polyvecl *s1,
-                                     polyveck *s2,
-                                     const uint8_t sk[PQCLEAN_MLDSA44_CLEAN_CRYPTO_SECRETKEYBYTES]) {
+void MLDSA_NAMESPACE(unpack_sk)(uint8_t rho[SEEDBYTES],
+                                uint8_t tr[TRBYTES],
+                                uint8_t key[SEEDBYTES],
+                                polyveck *t0,
+                                polyvecl *s1,
+                                polyveck *s2,
+                                const uint8_t sk[CRYPTO_SECRETKEYBYTES]) {
     unsigned int i;
 
     for (i = 0; i < SEEDBYTES; ++i) {
@@ -142,22 +142,79 @@ void PQCLEAN_MLDSA44_CLEAN_unpack_sk(uint8_t rho[SEEDBYTES],
     sk += TRBYTES;
 
     for (i = 0; i < L; ++i) {
-        PQCLEAN_MLDSA44_CLEAN_polyeta_unpack(&s1->vec[i], sk + i * POLYETA_PACKEDBYTES);
+        MLDSA_NAMESPACE(polyeta_unpack)(&s1->vec[i], sk + i * POLYETA_PACKEDBYTES);
     }
     sk += L * POLYETA_PACKEDBYTES;
 
     for (i = 0; i < K; ++i) {
-        PQCLEAN_MLDSA44_CLEAN_polyeta_unpack(&s2->vec[i], sk + i * POLYETA_PACKEDBYTES);
+        MLDSA_NAMESPACE(polyeta_unpack)(&s2->vec[i], sk + i * POLYETA_PACKEDBYTES);
     }
     sk += K * POLYETA_PACKEDBYTES;
 
     for (i = 0; i < K; ++i) {
-        PQCLEAN_MLDSA44_CLEAN_polyt0_unpack(&t0->vec[i], sk + i * POLYT0_PACKEDBYTES);
+        PQCLEAN_MLDSA_CLEAN_polyt0_unpack(&t0->vec[i], sk + i * POLYT0_PACKEDBYTES);
     }
 }
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_pack_sig
+* Name:        unpack_sk_compact
+*
+* Description: Unpack secret key sk = (rho, tr, key, t0, s1, s2) into the
+*              compact int8/int16 representation, one polynomial at a time.
+*
+* Arguments:   - const uint8_t rho[]: output byte array for rho
+*              - const uint8_t tr[]: output byte array for tr
+*              - const uint8_t key[]: output byte array for key
+*              - const polyveck_s16 *t0: pointer to output vector t0
+*              - const polyvecl_s8 *s1: pointer to output vector s1
+*              - const polyveck_s8 *s2: pointer to output vector s2
+*              - uint8_t sk[]: byte array containing bit-packed sk
+**************************************************/
+void MLDSA_NAMESPACE(unpack_sk_compact)(uint8_t rho[SEEDBYTES],
+        uint8_t tr[TRBYTES],
+        uint8_t key[SEEDBYTES],
+        polyveck_s16 *t0,
+        polyvecl_s8 *s1,
+        polyveck_s8 *s2,
+        const uint8_t sk[CRYPTO_SECRETKEYBYTES]) {
+    unsigned int i;
+    poly t;
+
+    for (i = 0; i < SEEDBYTES; ++i) {
+        rho[i] = sk[i];
+    }
+    sk += SEEDBYTES;
+
+    for (i = 0; i < SEEDBYTES; ++i) {
+        key[i] = sk[i];
+    }
+    sk += SEEDBYTES;
+
+    for (i = 0; i < TRBYTES; ++i) {
+        tr[i] = sk[i];
+    }
+    sk += TRBYTES;
+
+    for (i = 0; i < L; ++i) {
+        MLDSA_NAMESPACE(polyeta_unpack)(&t, sk + i * POLYETA_PACKEDBYTES);
+        PQCLEAN_MLDSA_CLEAN_poly_to_s8(&s1->vec[i], &t);
+    }
+    sk += L * POLYETA_PACKEDBYTES;
+
+    for (i = 0; i < K; ++i) {
+        MLDSA_NAMESPACE(polyeta_unpack)(&t, sk + i * POLYETA_PACKEDBYTES);
+        PQCLEAN_MLDSA_CLEAN_poly_to_s8(&s2->vec[i], &t);
+    }
+    sk += K * POLYETA_PACKEDBYTES;
+
+    for (i = 0; i < K; ++i) {
+        PQCLEAN_MLDSA_CLEAN_polyt0_unpack(&t, sk + i * POLYT0_PACKEDBYTES);
+        PQCLEAN_MLDSA_CLEAN_poly_to_s16(&t0->vec[i], &t);
+    }
+}
+
+/*************************************************
+* Name:        pack_sig
 *
 * Description: Bit-pack signature sig = (c, z, h).
 *
@@ -166,10 +223,10 @@ void PQCLEAN_MLDSA44_CLEAN_unpack_sk(uint8_t rho[SEEDBYTES],
 *              - const polyvecl *z: pointer to vector z
 *              - const polyveck *h: pointer to hint vector h
 **************************************************/
-void PQCLEAN_MLDSA44_CLEAN_pack_sig(uint8_t sig[PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES],
-                                    const uint8_t c[CTILDEBYTES],
-                                    const polyvecl *z,
-                                    const polyveck *h) {
+void MLDSA_NAMESPACE(pack_sig)(uint8_t sig[CRYPTO_BYTES],
+                               const uint8_t c[CTILDEBYTES],
+                               const polyvecl *z,
+                               const polyveck *h) {
     unsigned int i, j, k;
 
     for (i = 0; i < CTILDEBYTES; ++i) {
@@ -178,7 +235,7 @@ void PQCLEAN_MLDSA44_CLEAN_pack_sig(uint8_t sig[PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYT
     sig += CTILDEBYTES;
 
     for (i = 0; i < L; ++i) {
-        PQCLEAN_MLDSA44_CLEAN_polyz_pack(sig + i * POLYZ_PACKEDBYTES, &z->vec[i]);
+        MLDSA_NAMESPACE(polyz_pack)(sig + i * POLYZ_PACKEDBYTES, &z->vec[i]);
     }
     sig += L * POLYZ_PACKEDBYTES;
 
@@ -200,7 +257,7 @@ void PQCLEAN_MLDSA44_CLEAN_pack_sig(uint8_t sig[PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYT
 }
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_unpack_sig
+* Name:        unpack_sig
 *
 * Description: Unpack signature sig = (c, z, h).
 *
@@ -212,10 +269,10 @@ void PQCLEAN_MLDSA44_CLEAN_pack_sig(uint8_t sig[PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYT
 *
 * Returns 1 in case of malformed signature; otherwise 0.
 **************************************************/
-int PQCLEAN_MLDSA44_CLEAN_unpack_sig(uint8_t c[CTILDEBYTES],
-                                     polyvecl *z,
-                                     polyveck *h,
-                                     const uint8_t sig[PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES]) {
+int MLDSA_NAMESPACE(unpack_sig)(uint8_t c[CTILDEBYTES],
+                                polyvecl *z,
+                                polyveck *h,
+                                const uint8_t sig[CRYPTO_BYTES]) {
     unsigned int i, j, k;
 
     for (i = 0; i < CTILDEBYTES; ++i) {
@@ -224,7 +281,7 @@ int PQCLEAN_MLDSA44_CLEAN_unpack_sig(uint8_t c[CTILDEBYTES],
     sig += CTILDEBYTES;
 
     for (i = 0; i < L; ++i) {
-        PQCLEAN_MLDSA44_CLEAN_polyz_unpack(&z->vec[i], sig + i * POLYZ_PACKEDBYTES);
+        MLDSA_NAMESPACE(polyz_unpack)(&z->vec[i], sig + i * POLYZ_PACKEDBYTES);
     }
     sig += L * POLYZ_PACKEDBYTES;
 
@@ -0,0 +1,53 @@
+#include "parallel.h"
+#include <stddef.h>
+
+static MLDSA_NAMESPACE(par_for_fn) par_hook = NULL;
+
+/*************************************************
+* Name:        crypto_sign_set_parallel
+*
+* Description: Registers (or with NULL, removes) the fork-join hook used
+*              by signing and matrix expansion. Takes effect from the next
+*              call; a call already running finishes in the mode it
+*              started with or falls back to the calling task.
+*
+* Arguments:   - par_for_fn par_for: hook, or NULL for single-task mode
+**************************************************/
+void MLDSA_NAMESPACE(crypto_sign_set_parallel)(MLDSA_NAMESPACE(par_for_fn) par_for) {
+    par_hook = par_for;
+}
+
+/*************************************************
+* Name:        par_enabled
+*
+* Description: Tells whether a fork-join hook is registered
+*
+* Returns 1 if so, 0 otherwise
+**************************************************/
+int MLDSA_NAMESPACE(par_enabled)(void) {
+    return par_hook != NULL;
+}
+
+/*************************************************
+* Name:        par_for
+*
+* Description: Runs body(arg, i) for i in [0, n) through the registered
+*              hook, or in order on the calling task if there is none.
+*              Bodies must only touch data owned by their own index.
+*
+* Arguments:   - par_body body: function to run per index
+*              - void *arg: argument passed to every call
+*              - unsigned int n: number of indices
+**************************************************/
+void MLDSA_NAMESPACE(par_for)(MLDSA_NAMESPACE(par_body) body, void *arg, unsigned int n) {
+    MLDSA_NAMESPACE(par_for_fn) hook = par_hook;
+    unsigned int i;
+
+    if (hook != NULL) {
+        hook(body, arg, n);
+        return;
+    }
+    for (i = 0; i < n; ++i) {
+        body(arg, i);
+    }
+}
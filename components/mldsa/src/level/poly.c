@@ -0,0 +1,713 @@
+#include "ntt.h"
+#include "params.h"
+#include "poly.h"
+#include "reduce.h"
+#include "rounding.h"
+#include "symmetric.h"
+#include <stdint.h>
+
+#define DBENCH_START()
+#define DBENCH_STOP(t)
+
+/*************************************************
+* Name:        poly_power2round
+*
+* Description: For all coefficients c of the input polynomial,
+*              compute c0, c1 such that c mod Q = c1*2^D + c0
+*              with -2^{D-1} < c0 <= 2^{D-1}. Assumes coefficients to be
+*              standard representatives.
+*
+* Arguments:   - poly *a1: pointer to output polynomial with coefficients c1
+*              - poly *a0: pointer to output polynomial with coefficients c0
+*              - const poly *a: pointer to input polynomial
+**************************************************/
+void MLDSA_NAMESPACE(poly_power2round)(poly *a1, poly *a0, const poly *a) {
+    unsigned int i;
+    DBENCH_START();
+
+    for (i = 0; i < N; ++i) {
+        a1->coeffs[i] = MLDSA_NAMESPACE(power2round)(&a0->coeffs[i], a->coeffs[i]);
+    }
+
+    DBENCH_STOP(*tround);
+}
+
+/*************************************************
+* Name:        poly_decompose
+*
+* Description: For all coefficients c of the input polynomial,
+*              compute high and low bits c0, c1 such c mod Q = c1*ALPHA + c0
+*              with -ALPHA/2 < c0 <= ALPHA/2 except c1 = (Q-1)/ALPHA where we
+*              set c1 = 0 and -ALPHA/2 <= c0 = c mod Q - Q < 0.
+*              Assumes coefficients to be standard representatives.
+*
+* Arguments:   - poly *a1: pointer to output polynomial with coefficients c1
+*              - poly *a0: pointer to output polynomial with coefficients c0
+*              - const poly *a: pointer to input polynomial
+**************************************************/
+void MLDSA_NAMESPACE(poly_decompose)(poly *a1, poly *a0, const poly *a) {
+    unsigned int i;
+    DBENCH_START();
+
+    for (i = 0; i < N; ++i) {
+        a1->coeffs[i] = MLDSA_NAMESPACE(decompose)(&a0->coeffs[i], a->coeffs[i]);
+    }
+
+    DBENCH_STOP(*tround);
+}
+
+/*************************************************
+* Name:        poly_make_hint
+*
+* Description: Compute hint polynomial. The coefficients of which indicate
+*              whether the low bits of the corresponding coefficient of
+*              the input polynomial overflow into the high bits.
+*
+* Arguments:   - poly *h: pointer to output hint polynomial
+*              - const poly *a0: pointer to low part of input polynomial
+*              - const poly *a1: pointer to high part of input polynomial
+*
+* Returns number of 1 bits.
+**************************************************/
+unsigned int MLDSA_NAMESPACE(poly_make_hint)(poly *h, const poly *a0, const poly *a1) {
+    unsigned int i, s = 0;
+    DBENCH_START();
+
+    for (i = 0; i < N; ++i) {
+        h->coeffs[i] = MLDSA_NAMESPACE(make_hint)(a0->coeffs[i], a1->coeffs[i]);
+        s += h->coeffs[i];
+    }
+
+    DBENCH_STOP(*tround);
+    return s;
+}
+
+/*************************************************
+* Name:        poly_use_hint
+*
+* Description: Use hint polynomial to correct the high bits of a polynomial.
+*
+* Arguments:   - poly *b: pointer to output polynomial with corrected high bits
+*              - const poly *a: pointer to input polynomial
+*              - const poly *h: pointer to input hint polynomial
+**************************************************/
+void MLDSA_NAMESPACE(poly_use_hint)(poly *b, const poly *a, const poly *h) {
+    unsigned int i;
+    DBENCH_START();
+
+    for (i = 0; i < N; ++i) {
+        b->coeffs[i] = MLDSA_NAMESPACE(use_hint)(a->coeffs[i], h->coeffs[i]);
+    }
+
+    DBENCH_STOP(*tround);
+}
+
+/*************************************************
+* Name:        rej_eta
+*
+* Description: Sample uniformly random coefficients in [-ETA, ETA] by
+*              performing rejection sampling on array of random bytes.
+*
+* Arguments:   - int32_t *a: pointer to output array (allocated)
+*              - unsigned int len: number of coefficients to be sampled
+*              - const uint8_t *buf: array of random bytes
+*              - unsigned int buflen: length of array of random bytes
+*
+* Returns number of sampled coefficients. Can be smaller than len if not enough
+* random bytes were given.
+**************************************************/
+static unsigned int rej_eta(int32_t *a,
+                            unsigned int len,
+                            const uint8_t *buf,
+                            unsigned int buflen) {
+    unsigned int ctr, pos;
+    uint32_t t0, t1;
+    DBENCH_START();
+
+    ctr = pos = 0;
+    while (ctr < len && pos < buflen) {
+        t0 = buf[pos] & 0x0F;
+        t1 = buf[pos++] >> 4;
+
+#if ETA == 2
+        if (t0 < 15) {
+            t0 = t0 - (205 * t0 >> 10) * 5;
+            a[ctr++] = 2 - t0;
+        }
+        if (t1 < 15 && ctr < len) {
+            t1 = t1 - (205 * t1 >> 10) * 5;
+            a[ctr++] = 2 - t1;
+        }
+#elif ETA == 4
+        if (t0 < 9) {
+            a[ctr++] = 4 - t0;
+        }
+        if (t1 < 9 && ctr < len) {
+            a[ctr++] = 4 - t1;
+        }
+#endif
+    }
+
+    DBENCH_STOP(*tsample);
+    return ctr;
+}
+
+/*************************************************
+* Name:        poly_uniform_eta
+*
+* Description: Sample polynomial with uniformly random coefficients
+*              in [-ETA,ETA] by performing rejection sampling on the
+*              output stream from SHAKE256(seed|nonce)
+*
+* Arguments:   - poly *a: pointer to output polynomial
+*              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+*              - uint16_t nonce: 2-byte nonce
+**************************************************/
+#if ETA == 2
+#define POLY_UNIFORM_ETA_NBLOCKS ((136 + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+#elif ETA == 4
+#define POLY_UNIFORM_ETA_NBLOCKS ((227 + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+#endif
+void MLDSA_NAMESPACE(poly_uniform_eta)(poly *a,
+        const uint8_t seed[CRHBYTES],
+        uint16_t nonce) {
+    unsigned int ctr;
+    unsigned int buflen = POLY_UNIFORM_ETA_NBLOCKS * STREAM256_BLOCKBYTES;
+    uint8_t buf[POLY_UNIFORM_ETA_NBLOCKS * STREAM256_BLOCKBYTES];
+    stream256_state state;
+
+    stream256_init(&state, seed, nonce);
+    stream256_squeezeblocks(buf, POLY_UNIFORM_ETA_NBLOCKS, &state);
+
+    ctr = rej_eta(a->coeffs, N, buf, buflen);
+
+    while (ctr < N) {
+        stream256_squeezeblocks(buf, 1, &state);
+        ctr += rej_eta(a->coeffs + ctr, N - ctr, buf, STREAM256_BLOCKBYTES);
+    }
+    stream256_release(&state);
+}
+
+/*************************************************
+* Name:        poly_uniform_eta_4x
+*
+* Description: Sample four polynomials like poly_uniform_eta, advancing
+*              their SHAKE256 streams together
+*
+* Arguments:   - poly *a0..a3: pointers to output polynomials, NULL to skip
+*              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+*              - uint16_t nonce0..nonce3: 2-byte nonces
+**************************************************/
+void MLDSA_NAMESPACE(poly_uniform_eta_4x)(poly *a0, poly *a1, poly *a2, poly *a3,
+        const uint8_t seed[CRHBYTES],
+        uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3) {
+    unsigned int j, pending;
+    unsigned int ctr[4];
+    uint8_t buf[4][POLY_UNIFORM_ETA_NBLOCKS * STREAM256_BLOCKBYTES];
+    uint8_t *out[4];
+    poly *a[4] = {a0, a1, a2, a3};
+    const uint16_t nonce[4] = {nonce0, nonce1, nonce2, nonce3};
+    stream256x4_state state;
+
+    pending = 0;
+    for (j = 0; j < 4; ++j) {
+        out[j] = a[j] ? buf[j] : NULL;
+        pending |= a[j] ? 1u << j : 0;
+    }
+    stream256x4_init(&state, seed, nonce, pending);
+    stream256x4_squeezeblocks(out, POLY_UNIFORM_ETA_NBLOCKS, &state);
+
+    for (j = 0; j < 4; ++j) {
+        ctr[j] = 0;
+        if (pending & (1u << j)) {
+            ctr[j] = rej_eta(a[j]->coeffs, N, buf[j], POLY_UNIFORM_ETA_NBLOCKS * STREAM256_BLOCKBYTES);
+            if (ctr[j] == N) {
+                pending &= ~(1u << j);
+            }
+        }
+    }
+
+    while (pending) {
+        for (j = 0; j < 4; ++j) {
+            out[j] = (pending & (1u << j)) ? buf[j] : NULL;
+        }
+
+        stream256x4_squeezeblocks(out, 1, &state);
+        for (j = 0; j < 4; ++j) {
+            if (pending & (1u << j)) {
+                ctr[j] += rej_eta(a[j]->coeffs + ctr[j], N - ctr[j], buf[j], STREAM256_BLOCKBYTES);
+                if (ctr[j] == N) {
+                    pending &= ~(1u << j);
+                }
+            }
+        }
+    }
+}
+
+/*************************************************
+* Name:        poly_uniform_gamma1m1
+*
+* Description: Sample polynomial with uniformly random coefficients
+*              in [-(GAMMA1 - 1), GAMMA1] by unpacking output stream
+*              of SHAKE256(seed|nonce)
+*
+* Arguments:   - poly *a: pointer to output polynomial
+*              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+*              - uint16_t nonce: 16-bit nonce
+**************************************************/
+#define POLY_UNIFORM_GAMMA1_NBLOCKS ((POLYZ_PACKEDBYTES + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+void MLDSA_NAMESPACE(poly_uniform_gamma1)(poly *a,
+        const uint8_t seed[CRHBYTES],
+        uint16_t nonce) {
+    uint8_t buf[POLY_UNIFORM_GAMMA1_NBLOCKS * STREAM256_BLOCKBYTES];
+    stream256_state state;
+
+    stream256_init(&state, seed, nonce);
+    stream256_squeezeblocks(buf, POLY_UNIFORM_GAMMA1_NBLOCKS, &state);
+    stream256_release(&state);
+    MLDSA_NAMESPACE(polyz_unpack)(a, buf);
+}
+
+/*************************************************
+* Name:        poly_uniform_gamma1_4x
+*
+* Description: Sample four polynomials like poly_uniform_gamma1, advancing
+*              their SHAKE256 streams together
+*
+* Arguments:   - poly *a0..a3: pointers to output polynomials, NULL to skip
+*              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+*              - uint16_t nonce0..nonce3: 16-bit nonces
+**************************************************/
+void MLDSA_NAMESPACE(poly_uniform_gamma1_4x)(poly *a0, poly *a1, poly *a2, poly *a3,
+        const uint8_t seed[CRHBYTES],
+        uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3) {
+    unsigned int j, mask;
+    uint8_t buf[4][POLY_UNIFORM_GAMMA1_NBLOCKS * STREAM256_BLOCKBYTES];
+    uint8_t *out[4];
+    poly *a[4] = {a0, a1, a2, a3};
+    const uint16_t nonce[4] = {nonce0, nonce1, nonce2, nonce3};
+    stream256x4_state state;
+
+    mask = 0;
+    for (j = 0; j < 4; ++j) {
+        out[j] = a[j] ? buf[j] : NULL;
+        mask |= a[j] ? 1u << j : 0;
+    }
+    stream256x4_init(&state, seed, nonce, mask);
+    stream256x4_squeezeblocks(out, POLY_UNIFORM_GAMMA1_NBLOCKS, &state);
+
+    for (j = 0; j < 4; ++j) {
+        if (a[j]) {
+            MLDSA_NAMESPACE(polyz_unpack)(a[j], buf[j]);
+        }
+    }
+}
+
+/*************************************************
+* Name:        challenge_coeffs
+*
+* Description: Implementation of H. Samples the TAU nonzero coefficients
+*              in {-1,1} using the output stream of SHAKE256(seed).
+*
+* Arguments:   - int8_t c[N]: output coefficients
+*              - const uint8_t mu[]: byte array containing seed of length CTILDEBYTES
+**************************************************/
+static void challenge_coeffs(int8_t c[N], const uint8_t seed[CTILDEBYTES]) {
+    unsigned int i, b, pos;
+    uint64_t signs;
+    uint8_t buf[SHAKE256_RATE];
+    shake256incctx state;
+
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, seed, CTILDEBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(buf, sizeof buf, &state);
+
+    signs = 0;
+    for (i = 0; i < 8; ++i) {
+        signs |= (uint64_t)buf[i] << 8 * i;
+    }
+    pos = 8;
+
+    for (i = 0; i < N; ++i) {
+        c[i] = 0;
+    }
+    for (i = N - TAU; i < N; ++i) {
+        do {
+            if (pos >= SHAKE256_RATE) {
+                shake256_inc_squeeze(buf, sizeof buf, &state);
+                pos = 0;
+            }
+
+            b = buf[pos++];
+        } while (b > i);
+
+        c[i] = c[b];
+        c[b] = (int8_t)(1 - 2 * (signs & 1));
+        signs >>= 1;
+    }
+    shake256_inc_ctx_release(&state);
+}
+
+/*************************************************
+* Name:        challenge
+*
+* Description: Implementation of H. Samples polynomial with TAU nonzero
+*              coefficients in {-1,1} using the output stream of
+*              SHAKE256(seed).
+*
+* Arguments:   - poly *c: pointer to output polynomial
+*              - const uint8_t mu[]: byte array containing seed of length CTILDEBYTES
+**************************************************/
+void MLDSA_NAMESPACE(poly_challenge)(poly *c, const uint8_t seed[CTILDEBYTES]) {
+    unsigned int i;
+    int8_t t[N];
+
+    challenge_coeffs(t, seed);
+    for (i = 0; i < N; ++i) {
+        c->coeffs[i] = t[i];
+    }
+}
+
+/*************************************************
+* Name:        poly_challenge_sparse
+*
+* Description: Samples the same challenge as poly_challenge, but returns it
+*              as the list of its nonzero positions and their signs.
+*
+* Arguments:   - poly_sparse *c: pointer to output challenge
+*              - const uint8_t mu[]: byte array containing seed of length CTILDEBYTES
+**************************************************/
+void MLDSA_NAMESPACE(poly_challenge_sparse)(poly_sparse *c, const uint8_t seed[CTILDEBYTES]) {
+    unsigned int i, n;
+    int8_t t[N];
+
+    challenge_coeffs(t, seed);
+    n = 0;
+    for (i = 0; i < N; ++i) {
+        if (t[i]) {
+            c->pos[n] = (uint8_t)i;
+            c->sign[n] = t[i];
+            ++n;
+        }
+    }
+}
+
+/*************************************************
+* Name:        poly_sparse_mul
+*
+* Description: Multiplication of a polynomial with small coefficients by
+*              the challenge in Z[X]/(X^N + 1), as TAU signed shifted
+*              additions. No modular reduction is performed; the result
+*              is exact as long as TAU times the largest input coefficient
+*              fits in 32 bits. For s1 and s2 its coefficients are at most
+*              TAU*ETA, for t0 at most TAU*2^{D-1} in absolute value.
+*
+* Arguments:   - poly *r: pointer to output polynomial
+*              - const poly_sparse *c: pointer to challenge
+*              - const poly *a: pointer to input polynomial
+**************************************************/
+void MLDSA_NAMESPACE(poly_sparse_mul)(poly *r, const poly_sparse *c, const poly *a) {
+    unsigned int i, j, k;
+    int32_t s;
+
+    for (i = 0; i < N; ++i) {
+        r->coeffs[i] = 0;
+    }
+    for (k = 0; k < TAU; ++k) {
+        i = c->pos[k];
+        s = c->sign[k];
+        for (j = 0; j < N - i; ++j) {
+            r->coeffs[i + j] += s * a->coeffs[j];
+        }
+        for (; j < N; ++j) {
+            r->coeffs[i + j - N] -= s * a->coeffs[j];
+        }
+    }
+}
+
+/*************************************************
+* Name:        poly_sparse_mul_s8
+*
+* Description: Same as poly_sparse_mul for 8-bit coefficients; for s1 and
+*              s2 of a compact key.
+*
+* Arguments:   - poly *r: pointer to output polynomial
+*              - const poly_sparse *c: pointer to challenge
+*              - const poly_s8 *a: pointer to input polynomial
+**************************************************/
+void MLDSA_NAMESPACE(poly_sparse_mul_s8)(poly *r, const poly_sparse *c, const poly_s8 *a) {
+    unsigned int i, j, k;
+    int32_t s;
+
+    for (i = 0; i < N; ++i) {
+        r->coeffs[i] = 0;
+    }
+    for (k = 0; k < TAU; ++k) {
+        i = c->pos[k];
+        s = c->sign[k];
+        for (j = 0; j < N - i; ++j) {
+            r->coeffs[i + j] += s * a->coeffs[j];
+        }
+        for (; j < N; ++j) {
+            r->coeffs[i + j - N] -= s * a->coeffs[j];
+        }
+    }
+}
+
+/*************************************************
+* Name:        poly_sparse_mul_s16
+*
+* Description: Same as poly_sparse_mul for 16-bit coefficients; for t0 of
+*              a compact key.
+*
+* Arguments:   - poly *r: pointer to output polynomial
+*              - const poly_sparse *c: pointer to challenge
+*              - const poly_s16 *a: pointer to input polynomial
+**************************************************/
+void MLDSA_NAMESPACE(poly_sparse_mul_s16)(poly *r, const poly_sparse *c, const poly_s16 *a) {
+    unsigned int i, j, k;
+    int32_t s;
+
+    for (i = 0; i < N; ++i) {
+        r->coeffs[i] = 0;
+    }
+    for (k = 0; k < TAU; ++k) {
+        i = c->pos[k];
+        s = c->sign[k];
+        for (j = 0; j < N - i; ++j) {
+            r->coeffs[i + j] += s * a->coeffs[j];
+        }
+        for (; j < N; ++j) {
+            r->coeffs[i + j - N] -= s * a->coeffs[j];
+        }
+    }
+}
+
+/*************************************************
+* Name:        polyeta_pack
+*
+* Description: Bit-pack polynomial with coefficients in [-ETA,ETA].
+*
+* Arguments:   - uint8_t *r: pointer to output byte array with at least
+*                            POLYETA_PACKEDBYTES bytes
+*              - const poly *a: pointer to input polynomial
+**************************************************/
+void MLDSA_NAMESPACE(polyeta_pack)(uint8_t *r, const poly *a) {
+    unsigned int i;
+    uint8_t t[8];
+    DBENCH_START();
+
+#if ETA == 2
+    for (i = 0; i < N / 8; ++i) {
+        t[0] = (uint8_t) (ETA - a->coeffs[8 * i + 0]);
+        t[1] = (uint8_t) (ETA - a->coeffs[8 * i + 1]);
+        t[2] = (uint8_t) (ETA - a->coeffs[8 * i + 2]);
+        t[3] = (uint8_t) (ETA - a->coeffs[8 * i + 3]);
+        t[4] = (uint8_t) (ETA - a->coeffs[8 * i + 4]);
+        t[5] = (uint8_t) (ETA - a->coeffs[8 * i + 5]);
+        t[6] = (uint8_t) (ETA - a->coeffs[8 * i + 6]);
+        t[7] = (uint8_t) (ETA - a->coeffs[8 * i + 7]);
+
+        r[3 * i + 0]  = (t[0] >> 0) | (t[1] << 3) | (t[2] << 6);
+        r[3 * i + 1]  = (t[2] >> 2) | (t[3] << 1) | (t[4] << 4) | (t[5] << 7);
+        r[3 * i + 2]  = (t[5] >> 1) | (t[6] << 2) | (t[7] << 5);
+    }
+#elif ETA == 4
+    for (i = 0; i < N / 2; ++i) {
+        t[0] = (uint8_t) (ETA - a->coeffs[2 * i + 0]);
+        t[1] = (uint8_t) (ETA - a->coeffs[2 * i + 1]);
+        r[i] = t[0] | (t[1] << 4);
+    }
+#endif
+
+    DBENCH_STOP(*tpack);
+}
+
+/*************************************************
+* Name:        polyeta_unpack
+*
+* Description: Unpack polynomial with coefficients in [-ETA,ETA].
+*
+* Arguments:   - poly *r: pointer to output polynomial
+*              - const uint8_t *a: byte array with bit-packed polynomial
+**************************************************/
+void MLDSA_NAMESPACE(polyeta_unpack)(poly *r, const uint8_t *a) {
+    unsigned int i;
+    DBENCH_START();
+
+#if ETA == 2
+    for (i = 0; i < N / 8; ++i) {
+        r->coeffs[8 * i + 0] =  (a[3 * i + 0] >> 0) & 7;
+        r->coeffs[8 * i + 1] =  (a[3 * i + 0] >> 3) & 7;
+        r->coeffs[8 * i + 2] = ((a[3 * i + 0] >> 6) | (a[3 * i + 1] << 2)) & 7;
+        r->coeffs[8 * i + 3] =  (a[3 * i + 1] >> 1) & 7;
+        r->coeffs[8 * i + 4] =  (a[3 * i + 1] >> 4) & 7;
+        r->coeffs[8 * i + 5] = ((a[3 * i + 1] >> 7) | (a[3 * i + 2] << 1)) & 7;
+        r->coeffs[8 * i + 6] =  (a[3 * i + 2] >> 2) & 7;
+        r->coeffs[8 * i + 7] =  (a[3 * i + 2] >> 5) & 7;
+
+        r->coeffs[8 * i + 0] = ETA - r->coeffs[8 * i + 0];
+        r->coeffs[8 * i + 1] = ETA - r->coeffs[8 * i + 1];
+        r->coeffs[8 * i + 2] = ETA - r->coeffs[8 * i + 2];
+        r->coeffs[8 * i + 3] = ETA - r->coeffs[8 * i + 3];
+        r->coeffs[8 * i + 4] = ETA - r->coeffs[8 * i + 4];
+        r->coeffs[8 * i + 5] = ETA - r->coeffs[8 * i + 5];
+        r->coeffs[8 * i + 6] = ETA - r->coeffs[8 * i + 6];
+        r->coeffs[8 * i + 7] = ETA - r->coeffs[8 * i + 7];
+    }
+#elif ETA == 4
+    for (i = 0; i < N / 2; ++i) {
+        r->coeffs[2 * i + 0] = a[i] & 0x0F;
+        r->coeffs[2 * i + 1] = a[i] >> 4;
+        r->coeffs[2 * i + 0] = ETA - r->coeffs[2 * i + 0];
+        r->coeffs[2 * i + 1] = ETA - r->coeffs[2 * i + 1];
+    }
+#endif
+
+    DBENCH_STOP(*tpack);
+}
+
+/*************************************************
+* Name:        polyz_pack
+*
+* Description: Bit-pack polynomial with coefficients
+*              in [-(GAMMA1 - 1), GAMMA1].
+*
+* Arguments:   - uint8_t *r: pointer to output byte array with at least
+*                            POLYZ_PACKEDBYTES bytes
+*              - const poly *a: pointer to input polynomial
+**************************************************/
+void MLDSA_NAMESPACE(polyz_pack)(uint8_t *r, const poly *a) {
+    unsigned int i;
+    uint32_t t[4];
+    DBENCH_START();
+
+#if GAMMA1 == (1 << 17)
+    for (i = 0; i < N / 4; ++i) {
+        t[0] = GAMMA1 - a->coeffs[4 * i + 0];
+        t[1] = GAMMA1 - a->coeffs[4 * i + 1];
+        t[2] = GAMMA1 - a->coeffs[4 * i + 2];
+        t[3] = GAMMA1 - a->coeffs[4 * i + 3];
+
+        r[9 * i + 0]  = (uint8_t) t[0];
+        r[9 * i + 1]  = (uint8_t) (t[0] >> 8);
+        r[9 * i + 2]  = (uint8_t) (t[0] >> 16);
+        r[9 * i + 2] |= (uint8_t) (t[1] << 2);
+        r[9 * i + 3]  = (uint8_t) (t[1] >> 6);
+        r[9 * i + 4]  = (uint8_t) (t[1] >> 14);
+        r[9 * i + 4] |= (uint8_t) (t[2] << 4);
+        r[9 * i + 5]  = (uint8_t) (t[2] >> 4);
+        r[9 * i + 6]  = (uint8_t) (t[2] >> 12);
+        r[9 * i + 6] |= (uint8_t) (t[3] << 6);
+        r[9 * i + 7]  = (uint8_t) (t[3] >> 2);
+        r[9 * i + 8]  = (uint8_t) (t[3] >> 10);
+    }
+#elif GAMMA1 == (1 << 19)
+    for (i = 0; i < N / 2; ++i) {
+        t[0] = GAMMA1 - a->coeffs[2 * i + 0];
+        t[1] = GAMMA1 - a->coeffs[2 * i + 1];
+
+        r[5 * i + 0]  = (uint8_t) (t[0]);
+        r[5 * i + 1]  = (uint8_t) (t[0] >> 8);
+        r[5 * i + 2]  = (uint8_t) (t[0] >> 16);
+        r[5 * i + 2] |= (uint8_t) (t[1] << 4);
+        r[5 * i + 3]  = (uint8_t) (t[1] >> 4);
+        r[5 * i + 4]  = (uint8_t) (t[1] >> 12);
+    }
+#endif
+
+    DBENCH_STOP(*tpack);
+}
+
+/*************************************************
+* Name:        polyz_unpack
+*
+* Description: Unpack polynomial z with coefficients
+*              in [-(GAMMA1 - 1), GAMMA1].
+*
+* Arguments:   - poly *r: pointer to output polynomial
+*              - const uint8_t *a: byte array with bit-packed polynomial
+**************************************************/
+void MLDSA_NAMESPACE(polyz_unpack)(poly *r, const uint8_t *a) {
+    unsigned int i;
+    DBENCH_START();
+
+#if GAMMA1 == (1 << 17)
+    for (i = 0; i < N / 4; ++i) {
+        r->coeffs[4 * i + 0]  = a[9 * i + 0];
+        r->coeffs[4 * i + 0] |= (uint32_t)a[9 * i + 1] << 8;
+        r->coeffs[4 * i + 0] |= (uint32_t)a[9 * i + 2] << 16;
+        r->coeffs[4 * i + 0] &= 0x3FFFF;
+
+        r->coeffs[4 * i + 1]  = a[9 * i + 2] >> 2;
+        r->coeffs[4 * i + 1] |= (uint32_t)a[9 * i + 3] << 6;
+        r->coeffs[4 * i + 1] |= (uint32_t)a[9 * i + 4] << 14;
+        r->coeffs[4 * i + 1] &= 0x3FFFF;
+
+        r->coeffs[4 * i + 2]  = a[9 * i + 4] >> 4;
+        r->coeffs[4 * i + 2] |= (uint32_t)a[9 * i + 5] << 4;
+        r->coeffs[4 * i + 2] |= (uint32_t)a[9 * i + 6] << 12;
+        r->coeffs[4 * i + 2] &= 0x3FFFF;
+
+        r->coeffs[4 * i + 3]  = a[9 * i + 6] >> 6;
+        r->coeffs[4 * i + 3] |= (uint32_t)a[9 * i + 7] << 2;
+        r->coeffs[4 * i + 3] |= (uint32_t)a[9 * i + 8] << 10;
+        r->coeffs[4 * i + 3] &= 0x3FFFF;
+
+        r->coeffs[4 * i + 0] = GAMMA1 - r->coeffs[4 * i + 0];
+        r->coeffs[4 * i + 1] = GAMMA1 - r->coeffs[4 * i + 1];
+        r->coeffs[4 * i + 2] = GAMMA1 - r->coeffs[4 * i + 2];
+        r->coeffs[4 * i + 3] = GAMMA1 - r->coeffs[4 * i + 3];
+    }
+#elif GAMMA1 == (1 << 19)
+    for (i = 0; i < N / 2; ++i) {
+        r->coeffs[2 * i + 0]  = a[5 * i + 0];
+        r->coeffs[2 * i + 0] |= (uint32_t)a[5 * i + 1] << 8;
+        r->coeffs[2 * i + 0] |= (uint32_t)a[5 * i + 2] << 16;
+        r->coeffs[2 * i + 0] &= 0xFFFFF;
+
+        r->coeffs[2 * i + 1]  = a[5 * i + 2] >> 4;
+        r->coeffs[2 * i + 1] |= (uint32_t)a[5 * i + 3] << 4;
+        r->coeffs[2 * i + 1] |= (uint32_t)a[5 * i + 4] << 12;
+        /* r->coeffs[2*i+1] &= 0xFFFFF; */ /* No effect, since we're anyway at 20 bits */
+
+        r->coeffs[2 * i + 0] = GAMMA1 - r->coeffs[2 * i + 0];
+        r->coeffs[2 * i + 1] = GAMMA1 - r->coeffs[2 * i + 1];
+    }
+#endif
+
+    DBENCH_STOP(*tpack);
+}
+
+/*************************************************
+* Name:        polyw1_pack
+*
+* Description: Bit-pack polynomial w1 with coefficients in [0,15] or [0,43].
+*              Input coefficients are assumed to be standard representatives.
+*
+* Arguments:   - uint8_t *r: pointer to output byte array with at least
+*                            POLYW1_PACKEDBYTES bytes
+*              - const poly *a: pointer to input polynomial
+**************************************************/
+void MLDSA_NAMESPACE(polyw1_pack)(uint8_t *r, const poly *a) {
+    unsigned int i;
+    DBENCH_START();
+
+#if GAMMA2 == (Q-1)/88
+    for (i = 0; i < N / 4; ++i) {
+        r[3 * i + 0]  = (uint8_t) a->coeffs[4 * i + 0];
+        r[3 * i + 0] |= (uint8_t) (a->coeffs[4 * i + 1] << 6);
+        r[3 * i + 1]  = (uint8_t) (a->coeffs[4 * i + 1] >> 2);
+        r[3 * i + 1] |= (uint8_t) (a->coeffs[4 * i + 2] << 4);
+        r[3 * i + 2]  = (uint8_t) (a->coeffs[4 * i + 2] >> 4);
+        r[3 * i + 2] |= (uint8_t) (a->coeffs[4 * i + 3] << 2);
+    }
+#elif GAMMA2 == (Q-1)/32
+    for (i = 0; i < N / 2; ++i) {
+        r[i] = (uint8_t) (a->coeffs[2 * i + 0] | (a->coeffs[2 * i + 1] << 4));
+    }
+#endif
+
+    DBENCH_STOP(*tpack);
+}
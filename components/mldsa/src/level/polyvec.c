@@ -0,0 +1,531 @@
+#include "parallel.h"
+#include "params.h"
+#include "poly.h"
+#include "polyvec.h"
+#include "reduce.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/*************************************************
+* Name:        expand_mat_row
+*
+* Description: Samples row i of matrix A, i.e. a_{i,0..L-1}
+*
+* Arguments:   - polyvecl *row: output row
+*              - const uint8_t rho[]: byte array containing seed rho
+*              - unsigned int i: row index
+**************************************************/
+void MLDSA_NAMESPACE(polyvec_matrix_expand_row)(polyvecl *row, const uint8_t rho[SEEDBYTES], unsigned int i) {
+    unsigned int j;
+
+    for (j = 0; j < L; j += 4) {
+        PQCLEAN_MLDSA_CLEAN_poly_uniform_4x(&row->vec[j],
+                                            j + 1 < L ? &row->vec[j + 1] : NULL,
+                                            j + 2 < L ? &row->vec[j + 2] : NULL,
+                                            j + 3 < L ? &row->vec[j + 3] : NULL,
+                                            rho, (uint16_t) ((i << 8) + j), (uint16_t) ((i << 8) + j + 1),
+                                            (uint16_t) ((i << 8) + j + 2), (uint16_t) ((i << 8) + j + 3));
+    }
+}
+
+typedef struct {
+    polyvecl *mat;
+    const uint8_t *rho;
+} expand_args;
+
+static void expand_row_body(void *arg, unsigned int i) {
+    expand_args *args = arg;
+    MLDSA_NAMESPACE(polyvec_matrix_expand_row)(&args->mat[i], args->rho, i);
+}
+
+/*************************************************
+* Name:        expand_mat
+*
+* Description: Implementation of ExpandA. Generates matrix A with uniformly
+*              random coefficients a_{i,j} by performing rejection
+*              sampling on the output stream of SHAKE128(rho|j|i)
+*
+* Arguments:   - polyvecl mat[K]: output matrix
+*              - const uint8_t rho[]: byte array containing seed rho
+**************************************************/
+void MLDSA_NAMESPACE(polyvec_matrix_expand)(polyvecl mat[K], const uint8_t rho[SEEDBYTES]) {
+    unsigned int i, j, k;
+    poly *a[4];
+    uint16_t nonce[4];
+
+    /* With a fork-join hook, rows are independent units of work */
+    if (MLDSA_NAMESPACE(par_enabled)()) {
+        expand_args args = {mat, rho};
+        MLDSA_NAMESPACE(par_for)(expand_row_body, &args, K);
+        return;
+    }
+
+    /* Walk the K*L entries row-major, four SHAKE128 streams at a time */
+    for (k = 0; k < K * L; k += 4) {
+        for (j = 0; j < 4; ++j) {
+            i = k + j;
+            a[j] = i < K * L ? &mat[i / L].vec[i % L] : NULL;
+            nonce[j] = (uint16_t) (((i / L) << 8) + i % L);
+        }
+        PQCLEAN_MLDSA_CLEAN_poly_uniform_4x(a[0], a[1], a[2], a[3], rho,
+                                            nonce[0], nonce[1], nonce[2], nonce[3]);
+    }
+}
+
+void MLDSA_NAMESPACE(polyvec_matrix_pointwise_montgomery)(polyveck *t, const polyvecl mat[K], const polyvecl *v) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        MLDSA_NAMESPACE(polyvecl_pointwise_acc_montgomery)(&t->vec[i], &mat[i], v);
+    }
+}
+
+/*************************************************
+* Name:        polyvec_matrix_pointwise_invntt_tomont
+*
+* Description: Compute t = invntt(A*v) row by row, running the inverse NTT
+*              on each row while it is still hot instead of in a separate
+*              pass. Equivalent to matrix_pointwise_montgomery followed by
+*              polyveck_reduce and polyveck_invntt_tomont. Output
+*              coefficients are smaller than Q in absolute value.
+*
+* Arguments:   - polyveck *t: output vector
+*              - const polyvecl mat[K]: expanded matrix A (NTT domain)
+*              - const polyvecl *v: input vector (NTT domain)
+**************************************************/
+void MLDSA_NAMESPACE(polyvec_matrix_pointwise_invntt_tomont)(polyveck *t, const polyvecl mat[K], const polyvecl *v) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        MLDSA_NAMESPACE(polyvecl_pointwise_acc_montgomery)(&t->vec[i], &mat[i], v);
+        PQCLEAN_MLDSA_CLEAN_poly_invntt_tomont(&t->vec[i]);
+    }
+}
+
+/*************************************************
+* Name:        polyvec_matrix_stream_pointwise_montgomery
+*
+* Description: Same as polyvec_matrix_pointwise_montgomery, but regenerates
+*              A from rho one row at a time instead of reading an expanded
+*              matrix. Costs the sampling of all K*L entries per call and
+*              needs L polynomials of memory instead of K*L.
+*
+* Arguments:   - polyveck *t: output vector
+*              - polyvecl *row: buffer for one row of A
+*              - const uint8_t rho[]: byte array containing seed rho
+*              - const polyvecl *v: input vector (NTT domain)
+**************************************************/
+void MLDSA_NAMESPACE(polyvec_matrix_stream_pointwise_montgomery)(polyveck *t, polyvecl *row,
+        const uint8_t rho[SEEDBYTES], const polyvecl *v) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        MLDSA_NAMESPACE(polyvec_matrix_expand_row)(row, rho, i);
+        MLDSA_NAMESPACE(polyvecl_pointwise_acc_montgomery)(&t->vec[i], row, v);
+    }
+}
+
+/**************************************************************/
+/************ Vectors of polynomials of length L **************/
+/**************************************************************/
+
+void MLDSA_NAMESPACE(polyvecl_uniform_eta)(polyvecl *v, const uint8_t seed[CRHBYTES], uint16_t nonce) {
+    unsigned int i;
+
+    for (i = 0; i < L; i += 4) {
+        MLDSA_NAMESPACE(poly_uniform_eta_4x)(&v->vec[i],
+                i + 1 < L ? &v->vec[i + 1] : NULL,
+                i + 2 < L ? &v->vec[i + 2] : NULL,
+                i + 3 < L ? &v->vec[i + 3] : NULL,
+                seed, (uint16_t) (nonce + i), (uint16_t) (nonce + i + 1),
+                (uint16_t) (nonce + i + 2), (uint16_t) (nonce + i + 3));
+    }
+}
+
+void MLDSA_NAMESPACE(polyvecl_uniform_gamma1)(polyvecl *v, const uint8_t seed[CRHBYTES], uint16_t nonce) {
+    unsigned int i;
+
+    for (i = 0; i < L; i += 4) {
+        MLDSA_NAMESPACE(poly_uniform_gamma1_4x)(&v->vec[i],
+                i + 1 < L ? &v->vec[i + 1] : NULL,
+                i + 2 < L ? &v->vec[i + 2] : NULL,
+                i + 3 < L ? &v->vec[i + 3] : NULL,
+                seed, (uint16_t) (L * nonce + i), (uint16_t) (L * nonce + i + 1),
+                (uint16_t) (L * nonce + i + 2), (uint16_t) (L * nonce + i + 3));
+    }
+}
+
+void MLDSA_NAMESPACE(polyvecl_reduce)(polyvecl *v) {
+    unsigned int i;
+
+    for (i = 0; i < L; ++i) {
+        PQCLEAN_MLDSA_CLEAN_poly_reduce(&v->vec[i]);
+    }
+}
+
+/*************************************************
+* Name:        polyvecl_add
+*
+* Description: Add vectors of polynomials of length L.
+*              No modular reduction is performed.
+*
+* Arguments:   - polyvecl *w: pointer to output vector
+*              - const polyvecl *u: pointer to first summand
+*              - const polyvecl *v: pointer to second summand
+**************************************************/
+void MLDSA_NAMESPACE(polyvecl_add)(polyvecl *w, const polyvecl *u, const polyvecl *v) {
+    unsigned int i;
+
+    for (i = 0; i < L; ++i) {
+        PQCLEAN_MLDSA_CLEAN_poly_add(&w->vec[i], &u->vec[i], &v->vec[i]);
+    }
+}
+
+/*************************************************
+* Name:        polyvecl_ntt
+*
+* Description: Forward NTT of all polynomials in vector of length L. Output
+*              coefficients can be up to 16*Q larger than input coefficients.
+*
+* Arguments:   - polyvecl *v: pointer to input/output vector
+**************************************************/
+void MLDSA_NAMESPACE(polyvecl_ntt)(polyvecl *v) {
+    unsigned int i;
+
+    for (i = 0; i < L; ++i) {
+        PQCLEAN_MLDSA_CLEAN_poly_ntt(&v->vec[i]);
+    }
+}
+
+void MLDSA_NAMESPACE(polyvecl_invntt_tomont)(polyvecl *v) {
+    unsigned int i;
+
+    for (i = 0; i < L; ++i) {
+        PQCLEAN_MLDSA_CLEAN_poly_invntt_tomont(&v->vec[i]);
+    }
+}
+
+void MLDSA_NAMESPACE(polyvecl_pointwise_poly_montgomery)(polyvecl *r, const poly *a, const polyvecl *v) {
+    unsigned int i;
+
+    for (i = 0; i < L; ++i) {
+        PQCLEAN_MLDSA_CLEAN_poly_pointwise_montgomery(&r->vec[i], a, &v->vec[i]);
+    }
+}
+
+/*************************************************
+* Name:        polyvecl_pointwise_acc_montgomery
+*
+* Description: Pointwise multiply vectors of polynomials of length L, multiply
+*              resulting vector by 2^{-32} and add (accumulate) polynomials
+*              in it. Input/output vectors are in NTT domain representation.
+*              The products are summed in 64 bits and reduced once per
+*              coefficient, so output coefficients are smaller than Q in
+*              absolute value and can go to the inverse NTT as they are.
+*              Assumes input coefficients of u are in [0, Q) and those of v
+*              are smaller than 9*Q in absolute value (i.e. NTT output).
+*
+* Arguments:   - poly *w: output polynomial
+*              - const polyvecl *u: pointer to first input vector
+*              - const polyvecl *v: pointer to second input vector
+**************************************************/
+void MLDSA_NAMESPACE(polyvecl_pointwise_acc_montgomery)(poly *w,
+        const polyvecl *u,
+        const polyvecl *v) {
+    unsigned int i, j;
+    int64_t acc;
+
+    for (i = 0; i < N; ++i) {
+        acc = 0;
+        for (j = 0; j < L; ++j) {
+            acc += (int64_t)u->vec[j].coeffs[i] * v->vec[j].coeffs[i];
+        }
+        w->coeffs[i] = PQCLEAN_MLDSA_CLEAN_montgomery_reduce(acc);
+    }
+}
+
+/*************************************************
+* Name:        polyvecl_chknorm
+*
+* Description: Check infinity norm of polynomials in vector of length L.
+*              Assumes input polyvecl to be reduced by polyvecl_reduce().
+*
+* Arguments:   - const polyvecl *v: pointer to vector
+*              - int32_t B: norm bound
+*
+* Returns 0 if norm of all polynomials is strictly smaller than B <= (Q-1)/8
+* and 1 otherwise.
+**************************************************/
+int MLDSA_NAMESPACE(polyvecl_chknorm)(const polyvecl *v, int32_t bound)  {
+    unsigned int i;
+
+    for (i = 0; i < L; ++i) {
+        if (PQCLEAN_MLDSA_CLEAN_poly_chknorm(&v->vec[i], bound)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**************************************************************/
+/************ Vectors of polynomials of length K **************/
+/**************************************************************/
+
+void MLDSA_NAMESPACE(polyveck_uniform_eta)(polyveck *v, const uint8_t seed[CRHBYTES], uint16_t nonce) {
+    unsigned int i;
+
+    for (i = 0; i < K; i += 4) {
+        MLDSA_NAMESPACE(poly_uniform_eta_4x)(&v->vec[i],
+                i + 1 < K ? &v->vec[i + 1] : NULL,
+                i + 2 < K ? &v->vec[i + 2] : NULL,
+                i + 3 < K ? &v->vec[i + 3] : NULL,
+                seed, (uint16_t) (nonce + i), (uint16_t) (nonce + i + 1),
+                (uint16_t) (nonce + i + 2), (uint16_t) (nonce + i + 3));
+    }
+}
+
+/*************************************************
+* Name:        polyveck_reduce
+*
+* Description: Reduce coefficients of polynomials in vector of length K
+*              to representatives in [-6283008,6283008].
+*
+* Arguments:   - polyveck *v: pointer to input/output vector
+**************************************************/
+void MLDSA_NAMESPACE(polyveck_reduce)(polyveck *v) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        PQCLEAN_MLDSA_CLEAN_poly_reduce(&v->vec[i]);
+    }
+}
+
+/*************************************************
+* Name:        polyveck_caddq
+*
+* Description: For all coefficients of polynomials in vector of length K
+*              add Q if coefficient is negative.
+*
+* Arguments:   - polyveck *v: pointer to input/output vector
+**************************************************/
+void MLDSA_NAMESPACE(polyveck_caddq)(polyveck *v) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        PQCLEAN_MLDSA_CLEAN_poly_caddq(&v->vec[i]);
+    }
+}
+
+/*************************************************
+* Name:        polyveck_add
+*
+* Description: Add vectors of polynomials of length K.
+*              No modular reduction is performed.
+*
+* Arguments:   - polyveck *w: pointer to output vector
+*              - const polyveck *u: pointer to first summand
+*              - const polyveck *v: pointer to second summand
+**************************************************/
+void MLDSA_NAMESPACE(polyveck_add)(polyveck *w, const polyveck *u, const polyveck *v) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        PQCLEAN_MLDSA_CLEAN_poly_add(&w->vec[i], &u->vec[i], &v->vec[i]);
+    }
+}
+
+/*************************************************
+* Name:        polyveck_sub
+*
+* Description: Subtract vectors of polynomials of length K.
+*              No modular reduction is performed.
+*
+* Arguments:   - polyveck *w: pointer to output vector
+*              - const polyveck *u: pointer to first input vector
+*              - const polyveck *v: pointer to second input vector to be
+*                                   subtracted from first input vector
+**************************************************/
+void MLDSA_NAMESPACE(polyveck_sub)(polyveck *w, const polyveck *u, const polyveck *v) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        PQCLEAN_MLDSA_CLEAN_poly_sub(&w->vec[i], &u->vec[i], &v->vec[i]);
+    }
+}
+
+/*************************************************
+* Name:        polyveck_shiftl
+*
+* Description: Multiply vector of polynomials of Length K by 2^D without modular
+*              reduction. Assumes input coefficients to be less than 2^{31-D}.
+*
+* Arguments:   - polyveck *v: pointer to input/output vector
+**************************************************/
+void MLDSA_NAMESPACE(polyveck_shiftl)(polyveck *v) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        PQCLEAN_MLDSA_CLEAN_poly_shiftl(&v->vec[i]);
+    }
+}
+
+/*************************************************
+* Name:        polyveck_ntt
+*
+* Description: Forward NTT of all polynomials in vector of length K. Output
+*              coefficients can be up to 16*Q larger than input coefficients.
+*
+* Arguments:   - polyveck *v: pointer to input/output vector
+**************************************************/
+void MLDSA_NAMESPACE(polyveck_ntt)(polyveck *v) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        PQCLEAN_MLDSA_CLEAN_poly_ntt(&v->vec[i]);
+    }
+}
+
+/*************************************************
+* Name:        polyveck_invntt_tomont
+*
+* Description: Inverse NTT and multiplication by 2^{32} of polynomials
+*              in vector of length K. Input coefficients need to be less
+*              than 2*Q.
+*
+* Arguments:   - polyveck *v: pointer to input/output vector
+**************************************************/
+void MLDSA_NAMESPACE(polyveck_invntt_tomont)(polyveck *v) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        PQCLEAN_MLDSA_CLEAN_poly_invntt_tomont(&v->vec[i]);
+    }
+}
+
+void MLDSA_NAMESPACE(polyveck_pointwise_poly_montgomery)(polyveck *r, const poly *a, const polyveck *v) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        PQCLEAN_MLDSA_CLEAN_poly_pointwise_montgomery(&r->vec[i], a, &v->vec[i]);
+    }
+}
+
+
+/*************************************************
+* Name:        polyveck_chknorm
+*
+* Description: Check infinity norm of polynomials in vector of length K.
+*              Assumes input polyveck to be reduced by polyveck_reduce().
+*
+* Arguments:   - const polyveck *v: pointer to vector
+*              - int32_t B: norm bound
+*
+* Returns 0 if norm of all polynomials are strictly smaller than B <= (Q-1)/8
+* and 1 otherwise.
+**************************************************/
+int MLDSA_NAMESPACE(polyveck_chknorm)(const polyveck *v, int32_t bound) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        if (PQCLEAN_MLDSA_CLEAN_poly_chknorm(&v->vec[i], bound)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*************************************************
+* Name:        polyveck_power2round
+*
+* Description: For all coefficients a of polynomials in vector of length K,
+*              compute a0, a1 such that a mod^+ Q = a1*2^D + a0
+*              with -2^{D-1} < a0 <= 2^{D-1}. Assumes coefficients to be
+*              standard representatives.
+*
+* Arguments:   - polyveck *v1: pointer to output vector of polynomials with
+*                              coefficients a1
+*              - polyveck *v0: pointer to output vector of polynomials with
+*                              coefficients a0
+*              - const polyveck *v: pointer to input vector
+**************************************************/
+void MLDSA_NAMESPACE(polyveck_power2round)(polyveck *v1, polyveck *v0, const polyveck *v) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        MLDSA_NAMESPACE(poly_power2round)(&v1->vec[i], &v0->vec[i], &v->vec[i]);
+    }
+}
+
+/*************************************************
+* Name:        polyveck_decompose
+*
+* Description: For all coefficients a of polynomials in vector of length K,
+*              compute high and low bits a0, a1 such a mod^+ Q = a1*ALPHA + a0
+*              with -ALPHA/2 < a0 <= ALPHA/2 except a1 = (Q-1)/ALPHA where we
+*              set a1 = 0 and -ALPHA/2 <= a0 = a mod Q - Q < 0.
+*              Assumes coefficients to be standard representatives.
+*
+* Arguments:   - polyveck *v1: pointer to output vector of polynomials with
+*                              coefficients a1
+*              - polyveck *v0: pointer to output vector of polynomials with
+*                              coefficients a0
+*              - const polyveck *v: pointer to input vector
+**************************************************/
+void MLDSA_NAMESPACE(polyveck_decompose)(polyveck *v1, polyveck *v0, const polyveck *v) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        MLDSA_NAMESPACE(poly_decompose)(&v1->vec[i], &v0->vec[i], &v->vec[i]);
+    }
+}
+
+/*************************************************
+* Name:        polyveck_make_hint
+*
+* Description: Compute hint vector.
+*
+* Arguments:   - polyveck *h: pointer to output vector
+*              - const polyveck *v0: pointer to low part of input vector
+*              - const polyveck *v1: pointer to high part of input vector
+*
+* Returns number of 1 bits.
+**************************************************/
+unsigned int MLDSA_NAMESPACE(polyveck_make_hint)(polyveck *h,
+        const polyveck *v0,
+        const polyveck *v1) {
+    unsigned int i, s = 0;
+
+    for (i = 0; i < K; ++i) {
+        s += MLDSA_NAMESPACE(poly_make_hint)(&h->vec[i], &v0->vec[i], &v1->vec[i]);
+    }
+
+    return s;
+}
+
+/*************************************************
+* Name:        polyveck_use_hint
+*
+* Description: Use hint vector to correct the high bits of input vector.
+*
+* Arguments:   - polyveck *w: pointer to output vector of polynomials with
+*                             corrected high bits
+*              - const polyveck *u: pointer to input vector
+*              - const polyveck *h: pointer to input hint vector
+**************************************************/
+void MLDSA_NAMESPACE(polyveck_use_hint)(polyveck *w, const polyveck *v, const polyveck *h) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        MLDSA_NAMESPACE(poly_use_hint)(&w->vec[i], &v->vec[i], &h->vec[i]);
+    }
+}
+
+void MLDSA_NAMESPACE(polyveck_pack_w1)(uint8_t r[K * POLYW1_PACKEDBYTES], const polyveck *w1) {
+    unsigned int i;
+
+    for (i = 0; i < K; ++i) {
+        MLDSA_NAMESPACE(polyw1_pack)(&r[i * POLYW1_PACKEDBYTES], &w1->vec[i]);
+    }
+}
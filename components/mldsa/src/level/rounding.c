@@ -3,7 +3,7 @@
 #include <stdint.h>
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_power2round
+* Name:        power2round
 *
 * Description: For finite field element a, compute a0, a1 such that
 *              a mod^+ Q = a1*2^D + a0 with -2^{D-1} < a0 <= 2^{D-1}.
@@ -14,7 +14,7 @@
 *
 * Returns a1.
 **************************************************/
-int32_t PQCLEAN_MLDSA44_CLEAN_power2round(int32_t *a0, int32_t a)  {
+int32_t MLDSA_NAMESPACE(power2round)(int32_t *a0, int32_t a)  {
     int32_t a1;
 
     a1 = (a + (1 << (D - 1)) - 1) >> D;
@@ -23,7 +23,7 @@ int32_t PQCLEAN_MLDSA44_CLEAN_power2round(int32_t *a0, int32_t a)  {
 }
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_decompose
+* Name:        decompose
 *
 * Description: For finite field element a, compute high and low bits a0, a1 such
 *              that a mod^+ Q = a1*ALPHA + a0 with -ALPHA/2 < a0 <= ALPHA/2 except
@@ -36,12 +36,17 @@ int32_t PQCLEAN_MLDSA44_CLEAN_power2round(int32_t *a0, int32_t a)  {
 *
 * Returns a1.
 **************************************************/
-int32_t PQCLEAN_MLDSA44_CLEAN_decompose(int32_t *a0, int32_t a) {
+int32_t MLDSA_NAMESPACE(decompose)(int32_t *a0, int32_t a) {
     int32_t a1;
 
     a1  = (a + 127) >> 7;
+#if GAMMA2 == (Q-1)/32
+    a1  = (a1 * 1025 + (1 << 21)) >> 22;
+    a1 &= 15;
+#elif GAMMA2 == (Q-1)/88
     a1  = (a1 * 11275 + (1 << 23)) >> 24;
     a1 ^= ((43 - a1) >> 31) & a1;
+#endif
 
     *a0  = a - a1 * 2 * GAMMA2;
     *a0 -= (((Q - 1) / 2 - *a0) >> 31) & Q;
@@ -49,7 +54,7 @@ int32_t PQCLEAN_MLDSA44_CLEAN_decompose(int32_t *a0, int32_t a) {
 }
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_make_hint
+* Name:        make_hint
 *
 * Description: Compute hint bit indicating whether the low bits of the
 *              input element overflow into the high bits.
@@ -59,7 +64,7 @@ int32_t PQCLEAN_MLDSA44_CLEAN_decompose(int32_t *a0, int32_t a) {
 *
 * Returns 1 if overflow.
 **************************************************/
-unsigned int PQCLEAN_MLDSA44_CLEAN_make_hint(int32_t a0, int32_t a1) {
+unsigned int MLDSA_NAMESPACE(make_hint)(int32_t a0, int32_t a1) {
     if (a0 > GAMMA2 || a0 < -GAMMA2 || (a0 == -GAMMA2 && a1 != 0)) {
         return 1;
     }
@@ -68,7 +73,7 @@ unsigned int PQCLEAN_MLDSA44_CLEAN_make_hint(int32_t a0, int32_t a1) {
 }
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_use_hint
+* Name:        use_hint
 *
 * Description: Correct high bits according to hint.
 *
@@ -77,14 +82,20 @@ unsigned int PQCLEAN_MLDSA44_CLEAN_make_hint(int32_t a0, int32_t a1) {
 *
 * Returns corrected high bits.
 **************************************************/
-int32_t PQCLEAN_MLDSA44_CLEAN_use_hint(int32_t a, unsigned int hint) {
+int32_t MLDSA_NAMESPACE(use_hint)(int32_t a, unsigned int hint) {
     int32_t a0, a1;
 
-    a1 = PQCLEAN_MLDSA44_CLEAN_decompose(&a0, a);
+    a1 = MLDSA_NAMESPACE(decompose)(&a0, a);
     if (hint == 0) {
         return a1;
     }
 
+#if GAMMA2 == (Q-1)/32
+    if (a0 > 0) {
+        return (a1 + 1) & 15;
+    }
+    return (a1 - 1) & 15;
+#elif GAMMA2 == (Q-1)/88
     if (a0 > 0) {
         if (a1 == 43) {
             return 0;
@@ -95,4 +106,5 @@ int32_t PQCLEAN_MLDSA44_CLEAN_use_hint(int32_t a, unsigned int hint) {
         return 43;
     }
     return a1 - 1;
+#endif
 }
@@ -0,0 +1,1707 @@
+#include "fips202.h"
+#include "packing.h"
+#include "parallel.h"
+#include "params.h"
+#include <stdio.h>
+#include "poly.h"
+#include "polyvec.h"
+#include "randombytes.h"
+#include "sign.h"
+#include "symmetric.h"
+#include <stdint.h>
+#include <stdlib.h>    // For malloc, free
+#include <string.h>
+#include MLDSA_API_H
+
+/* api.h publishes the sizes as literals; they must match params.h */
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_PUBLICKEYBYTES) == CRYPTO_PUBLICKEYBYTES,
+               "api.h and params.h disagree on CRYPTO_PUBLICKEYBYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_SECRETKEYBYTES) == CRYPTO_SECRETKEYBYTES,
+               "api.h and params.h disagree on CRYPTO_SECRETKEYBYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_BYTES) == CRYPTO_BYTES,
+               "api.h and params.h disagree on CRYPTO_BYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_WORKSPACEBYTES) == CRYPTO_WORKSPACEBYTES,
+               "api.h and params.h disagree on CRYPTO_WORKSPACEBYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_EXPANDEDSKBYTES) == CRYPTO_EXPANDEDSKBYTES,
+               "api.h and params.h disagree on CRYPTO_EXPANDEDSKBYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_ESK_WORKSPACEBYTES) == CRYPTO_ESK_WORKSPACEBYTES,
+               "api.h and params.h disagree on CRYPTO_ESK_WORKSPACEBYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_ESK_SPEC_WORKSPACEBYTES) == CRYPTO_ESK_SPEC_WORKSPACEBYTES,
+               "api.h and params.h disagree on CRYPTO_ESK_SPEC_WORKSPACEBYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_EXPANDEDSK_STREAMBYTES) == CRYPTO_EXPANDEDSK_STREAMBYTES,
+               "api.h and params.h disagree on CRYPTO_EXPANDEDSK_STREAMBYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_VERIFY_STREAM_WORKSPACEBYTES) == CRYPTO_VERIFY_STREAM_WORKSPACEBYTES,
+               "api.h and params.h disagree on CRYPTO_VERIFY_STREAM_WORKSPACEBYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_EXPANDEDSK_COMPACTBYTES) == CRYPTO_EXPANDEDSK_COMPACTBYTES,
+               "api.h and params.h disagree on CRYPTO_EXPANDEDSK_COMPACTBYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_PRESIGBYTES) == CRYPTO_PRESIGBYTES,
+               "api.h and params.h disagree on CRYPTO_PRESIGBYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_BATCH_WORKSPACEBYTES) == CRYPTO_BATCH_WORKSPACEBYTES,
+               "api.h and params.h disagree on CRYPTO_BATCH_WORKSPACEBYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_EXPANDEDPKBYTES) == CRYPTO_EXPANDEDPKBYTES,
+               "api.h and params.h disagree on CRYPTO_EXPANDEDPKBYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_VERIFY_EPK_WORKSPACEBYTES) == CRYPTO_VERIFY_EPK_WORKSPACEBYTES,
+               "api.h and params.h disagree on CRYPTO_VERIFY_EPK_WORKSPACEBYTES");
+_Static_assert(MLDSA_NAMESPACE(CRYPTO_SIGN_STATEBYTES) == CRYPTO_SIGN_STATEBYTES,
+               "api.h and params.h disagree on CRYPTO_SIGN_STATEBYTES");
+
+_Static_assert(sizeof(MLDSA_NAMESPACE(workspace)) <= CRYPTO_WORKSPACEBYTES,
+               "CRYPTO_WORKSPACEBYTES is too small");
+_Static_assert(sizeof(MLDSA_NAMESPACE(expanded_sk)) <= CRYPTO_EXPANDEDSKBYTES,
+               "CRYPTO_EXPANDEDSKBYTES is too small");
+_Static_assert(sizeof(MLDSA_NAMESPACE(expanded_sk_stream)) <= CRYPTO_EXPANDEDSK_STREAMBYTES,
+               "CRYPTO_EXPANDEDSK_STREAMBYTES is too small");
+_Static_assert(sizeof(MLDSA_NAMESPACE(expanded_sk_compact)) <= CRYPTO_EXPANDEDSK_COMPACTBYTES,
+               "CRYPTO_EXPANDEDSK_COMPACTBYTES is too small");
+_Static_assert(sizeof(MLDSA_NAMESPACE(verify_stream_workspace)) <= CRYPTO_VERIFY_STREAM_WORKSPACEBYTES,
+               "CRYPTO_VERIFY_STREAM_WORKSPACEBYTES is too small");
+_Static_assert(sizeof(MLDSA_NAMESPACE(sign_scratch)) <= CRYPTO_ESK_WORKSPACEBYTES,
+               "CRYPTO_ESK_WORKSPACEBYTES is too small");
+_Static_assert(2 * sizeof(MLDSA_NAMESPACE(sign_scratch)) <= CRYPTO_ESK_SPEC_WORKSPACEBYTES,
+               "CRYPTO_ESK_SPEC_WORKSPACEBYTES is too small");
+_Static_assert(sizeof(MLDSA_NAMESPACE(presig)) <= CRYPTO_PRESIGBYTES,
+               "CRYPTO_PRESIGBYTES is too small");
+_Static_assert(sizeof(MLDSA_NAMESPACE(sign_scratch)) <= CRYPTO_BATCH_WORKSPACEBYTES,
+               "CRYPTO_BATCH_WORKSPACEBYTES is too small");
+_Static_assert(sizeof(MLDSA_NAMESPACE(expanded_pk)) <= CRYPTO_EXPANDEDPKBYTES,
+               "CRYPTO_EXPANDEDPKBYTES is too small");
+_Static_assert(sizeof(MLDSA_NAMESPACE(verify_scratch)) <= CRYPTO_VERIFY_EPK_WORKSPACEBYTES,
+               "CRYPTO_VERIFY_EPK_WORKSPACEBYTES is too small");
+_Static_assert(sizeof(shake256incctx) <= CRYPTO_SIGN_STATEBYTES,
+               "CRYPTO_SIGN_STATEBYTES is too small");
+_Static_assert(2 * K * POLYW1_PACKEDBYTES <= CRYPTO_BYTES,
+               "speculative signing packs two w1 into the signature buffer");
+
+/*************************************************
+* Name:        crypto_sign_seed_keypair_ws
+*
+* Description: Generates public and private key from a 32-byte seed
+*              (ML-DSA.KeyGen_internal of FIPS 204), using a caller-supplied
+*              workspace. Performs no heap allocation.
+*
+* Arguments:   - uint8_t *pk:   pointer to output public key (allocated
+*                               array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk:   pointer to output private key (allocated
+*                               array of CRYPTO_SECRETKEYBYTES bytes)
+*              - uint8_t *seed: pointer to seed of SEEDBYTES bytes
+*              - void *ws:      pointer to workspace of at least
+*                               CRYPTO_WORKSPACEBYTES bytes,
+*                               aligned for uint32_t
+*
+* Returns 0 (success)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_seed_keypair_ws)(uint8_t *pk, uint8_t *sk,
+        const uint8_t *seed, void *ws) {
+    MLDSA_NAMESPACE(workspace) *w = ws;
+    uint8_t *seedbuf = w->keypair.seedbuf;
+    uint8_t *tr = w->keypair.tr;
+    const uint8_t *rho, *rhoprime, *key;
+    polyvecl *mat = w->keypair.mat;
+    polyvecl *s1 = &w->keypair.s1;
+    polyvecl *s1hat = &w->keypair.s1hat;
+    polyveck *s2 = &w->keypair.s2;
+    polyveck *t1 = &w->keypair.t1;
+    polyveck *t0 = &w->keypair.t0;
+    unsigned int i;
+
+    /* Expand the seed into rho, rhoprime and key */
+    for (i = 0; i < SEEDBYTES; ++i) {
+        seedbuf[i] = seed[i];
+    }
+    seedbuf[SEEDBYTES + 0] = K;
+    seedbuf[SEEDBYTES + 1] = L;
+    shake256(seedbuf, 2 * SEEDBYTES + CRHBYTES, seedbuf, SEEDBYTES + 2);
+    rho = seedbuf;
+    rhoprime = rho + SEEDBYTES;
+    key = rhoprime + CRHBYTES;
+
+    /* Expand matrix */
+    MLDSA_NAMESPACE(polyvec_matrix_expand)(mat, rho);
+
+    /* Sample short vectors s1 and s2 */
+    MLDSA_NAMESPACE(polyvecl_uniform_eta)(s1, rhoprime, 0);
+    MLDSA_NAMESPACE(polyveck_uniform_eta)(s2, rhoprime, L);
+
+    /* Matrix-vector multiplication */
+    *s1hat = *s1;
+    MLDSA_NAMESPACE(polyvecl_ntt)(s1hat);
+    MLDSA_NAMESPACE(polyvec_matrix_pointwise_invntt_tomont)(t1, mat, s1hat);
+
+    /* Add error vector s2 */
+    MLDSA_NAMESPACE(polyveck_add)(t1, t1, s2);
+
+    /* Extract t1 and write public key */
+    MLDSA_NAMESPACE(polyveck_caddq)(t1);
+    MLDSA_NAMESPACE(polyveck_power2round)(t1, t0, t1);
+    MLDSA_NAMESPACE(pack_pk)(pk, rho, t1);
+
+    /* Compute H(rho, t1) and write secret key */
+    shake256(tr, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+    MLDSA_NAMESPACE(pack_sk)(sk, rho, tr, key, t0, s1, s2);
+
+    return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_keypair_ws
+*
+* Description: Generates public and private key using a caller-supplied
+*              workspace. Performs no heap allocation.
+*
+* Arguments:   - uint8_t *pk: pointer to output public key (allocated
+*                             array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key (allocated
+*                             array of CRYPTO_SECRETKEYBYTES bytes)
+*              - void *ws:    pointer to workspace of at least
+*                             CRYPTO_WORKSPACEBYTES bytes,
+*                             aligned for uint32_t
+*
+* Returns 0 (success)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_keypair_ws)(uint8_t *pk, uint8_t *sk, void *ws) {
+    MLDSA_NAMESPACE(workspace) *w = ws;
+
+    /* Get randomness for rho, rhoprime and key */
+    randombytes(w->keypair.seedbuf, SEEDBYTES);
+    return MLDSA_NAMESPACE(crypto_sign_seed_keypair_ws)(pk, sk, w->keypair.seedbuf, ws);
+}
+
+/*************************************************
+* Name:        crypto_sign_keypair
+*
+* Description: Generates public and private key. Allocates a workspace
+*              on the heap for the duration of the call.
+*
+* Arguments:   - uint8_t *pk: pointer to output public key (allocated
+*                             array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key (allocated
+*                             array of CRYPTO_SECRETKEYBYTES bytes)
+*
+* Returns 0 (success) or -1 (out of memory)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_keypair)(uint8_t *pk, uint8_t *sk) {
+    int ret;
+    MLDSA_NAMESPACE(workspace) *ws = malloc(sizeof(MLDSA_NAMESPACE(workspace)));
+    if (ws == NULL) {
+        return -1;
+    }
+
+    ret = MLDSA_NAMESPACE(crypto_sign_keypair_ws)(pk, sk, ws);
+    free(ws);
+    return ret;
+}
+
+
+/*************************************************
+* Name:        crypto_sign_expand_sk
+*
+* Description: Expands a bit-packed secret key into the form used by the
+*              signing loop: matrix A in NTT domain and the secret vectors
+*              s1, s2, t0, in NTT domain unless SPARSE_CHALLENGE is set,
+*              together with tr and key. Done once per
+*              key, this removes the matrix expansion, unpacking and
+*              forward NTTs from every signature.
+*
+* Arguments:   - void *esk:       pointer to output expanded key of at least
+*                                 CRYPTO_EXPANDEDSKBYTES bytes,
+*                                 aligned for uint32_t
+*              - const uint8_t *sk: pointer to bit-packed secret key
+*
+* Returns 0 (success)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_expand_sk)(void *esk, const uint8_t *sk) {
+    MLDSA_NAMESPACE(expanded_sk) *e = esk;
+
+    MLDSA_NAMESPACE(crypto_sign_expand_sk_stream)(&e->k, sk);
+    MLDSA_NAMESPACE(polyvec_matrix_expand)(e->mat, e->k.hd.rho);
+    e->k.hd.form = ESK_FORM_FULL;
+
+    return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_expand_sk_stream
+*
+* Description: Like crypto_sign_expand_sk, but leaves out matrix A. Signing
+*              from this form regenerates A from rho row by row on every
+*              attempt, trading that sampling work for K*L polynomials
+*              less memory. The result can be passed wherever an expanded
+*              key is taken.
+*
+* Arguments:   - void *esk:       pointer to output expanded key of at least
+*                                 CRYPTO_EXPANDEDSK_STREAMBYTES bytes,
+*                                 aligned for uint32_t
+*              - const uint8_t *sk: pointer to bit-packed secret key
+*
+* Returns 0 (success)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_expand_sk_stream)(void *esk, const uint8_t *sk) {
+    MLDSA_NAMESPACE(expanded_sk_stream) *e = esk;
+
+    MLDSA_NAMESPACE(unpack_sk)(e->hd.rho, e->hd.tr, e->hd.key, &e->t0, &e->s1, &e->s2, sk);
+
+#if !SPARSE_CHALLENGE
+    MLDSA_NAMESPACE(polyvecl_ntt)(&e->s1);
+    MLDSA_NAMESPACE(polyveck_ntt)(&e->s2);
+    MLDSA_NAMESPACE(polyveck_ntt)(&e->t0);
+#endif
+    e->hd.form = ESK_FORM_STREAM;
+
+    return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_expand_sk_compact
+*
+* Description: Like crypto_sign_expand_sk_stream, but keeps s1 and s2 in
+*              8 and t0 in 16 bits per coefficient, outside NTT domain.
+*              Signing multiplies them by the sparse challenge directly.
+*              This is the smallest form, about a third of the streaming
+*              one. The result can be passed wherever an expanded key is
+*              taken.
+*
+* Arguments:   - void *esk:       pointer to output expanded key of at least
+*                                 CRYPTO_EXPANDEDSK_COMPACTBYTES bytes,
+*                                 aligned for uint32_t
+*              - const uint8_t *sk: pointer to bit-packed secret key
+*
+* Returns 0 (success)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_expand_sk_compact)(void *esk, const uint8_t *sk) {
+    MLDSA_NAMESPACE(expanded_sk_compact) *e = esk;
+
+    MLDSA_NAMESPACE(unpack_sk_compact)(e->hd.rho, e->hd.tr, e->hd.key, &e->t0, &e->s1, &e->s2, sk);
+    e->hd.form = ESK_FORM_COMPACT;
+
+    return 0;
+}
+
+/* An expanded key of any form, as the rejection loop sees it */
+typedef struct {
+    const MLDSA_NAMESPACE(esk_header) *hd;
+    const polyvecl *mat;                                    /* NULL: streamed */
+    const MLDSA_NAMESPACE(expanded_sk_stream) *wide;   /* NULL: compact */
+    const MLDSA_NAMESPACE(expanded_sk_compact) *compact;
+    int sparse;                     /* challenge products without the NTT */
+} sign_key;
+
+static void sign_key_init(sign_key *k, const void *esk) {
+    k->hd = esk;
+    k->mat = NULL;
+    k->wide = NULL;
+    k->compact = NULL;
+    if (k->hd->form == ESK_FORM_COMPACT) {
+        k->compact = esk;
+    } else {
+        k->wide = esk;
+    }
+    k->sparse = k->compact != NULL || SPARSE_CHALLENGE;
+    if (k->hd->form == ESK_FORM_FULL) {
+        k->mat = ((const MLDSA_NAMESPACE(expanded_sk) *)esk)->mat;
+    }
+}
+
+/* Per-attempt state shared with the fork-join bodies below. Each body only
+ * writes the polynomials of its own index; reject is only ever set, so the
+ * bodies still running may skip their work once another one has failed.
+ * The bodies run on both cores and access reject with relaxed atomics: it
+ * orders nothing, and the join publishes the final value. */
+typedef struct {
+    const sign_key *k;
+    MLDSA_NAMESPACE(sign_scratch) *w;
+    const uint8_t *rhoprime;
+    uint16_t nonce;
+    int reject;
+} sign_par_args;
+
+/* y_i = ExpandMask(rhoprime, L*nonce + i), z_i = NTT(y_i) */
+static void sign_par_mask(void *arg, unsigned int i) {
+    sign_par_args *a = arg;
+    MLDSA_NAMESPACE(poly_uniform_gamma1)(&a->w->y.vec[i], a->rhoprime, (uint16_t) (L * a->nonce + i));
+    a->w->z.vec[i] = a->w->y.vec[i];
+    PQCLEAN_MLDSA_CLEAN_poly_ntt(&a->w->z.vec[i]);
+}
+
+/* Row i of w = A*z, split into high bits w1_i and low bits w0_i */
+static void sign_par_w(void *arg, unsigned int i) {
+    sign_par_args *a = arg;
+    poly *w1 = &a->w->w1.vec[i];
+    MLDSA_NAMESPACE(polyvecl_pointwise_acc_montgomery)(w1, &a->k->mat[i], &a->w->z);
+    PQCLEAN_MLDSA_CLEAN_poly_invntt_tomont(w1);
+    PQCLEAN_MLDSA_CLEAN_poly_caddq(w1);
+    MLDSA_NAMESPACE(poly_decompose)(w1, &a->w->w0.vec[i], w1);
+}
+
+/* r = c*s for a secret polynomial s of a full or streaming key */
+static void challenge_mul(poly *r, const sign_key *k,
+                          const MLDSA_NAMESPACE(sign_scratch) *w, const poly *s) {
+    if (k->sparse) {
+        MLDSA_NAMESPACE(poly_sparse_mul)(r, &w->csp, s);
+    } else {
+        PQCLEAN_MLDSA_CLEAN_poly_pointwise_montgomery(r, &w->cp, s);
+        PQCLEAN_MLDSA_CLEAN_poly_invntt_tomont(r);
+    }
+}
+
+/* i < L: z_i = y_i + c*s1_i. Otherwise, for k = i - L:
+ * w0_k -= c*s2_k and h_k = c*t0_k. Each polynomial is checked against its
+ * bound as soon as it is formed, and the first one out of bounds rejects
+ * the attempt. The sparse challenge gives the exact products; the
+ * reductions below map them and the NTT ones to the same
+ * representatives. */
+static void sign_par_response(void *arg, unsigned int i) {
+    sign_par_args *a = arg;
+    const MLDSA_NAMESPACE(expanded_sk_stream) *e = a->k->wide;
+    const MLDSA_NAMESPACE(expanded_sk_compact) *ec = a->k->compact;
+    poly *z, *w0, *h, t;
+
+    if (__atomic_load_n(&a->reject, __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    if (i < L) {
+        z = &a->w->z.vec[i];
+        if (ec) {
+            MLDSA_NAMESPACE(poly_sparse_mul_s8)(z, &a->w->csp, &ec->s1.vec[i]);
+        } else {
+            challenge_mul(z, a->k, a->w, &e->s1.vec[i]);
+        }
+        PQCLEAN_MLDSA_CLEAN_poly_add(z, z, &a->w->y.vec[i]);
+        PQCLEAN_MLDSA_CLEAN_poly_reduce(z);
+        if (PQCLEAN_MLDSA_CLEAN_poly_chknorm(z, GAMMA1 - BETA)) {
+            __atomic_store_n(&a->reject, 1, __ATOMIC_RELAXED);
+        }
+        return;
+    }
+
+    i -= L;
+    w0 = &a->w->w0.vec[i];
+    h = &a->w->h.vec[i];
+    if (ec) {
+        MLDSA_NAMESPACE(poly_sparse_mul_s8)(&t, &a->w->csp, &ec->s2.vec[i]);
+    } else {
+        challenge_mul(&t, a->k, a->w, &e->s2.vec[i]);
+    }
+    PQCLEAN_MLDSA_CLEAN_poly_sub(w0, w0, &t);
+    PQCLEAN_MLDSA_CLEAN_poly_reduce(w0);
+    if (PQCLEAN_MLDSA_CLEAN_poly_chknorm(w0, GAMMA2 - BETA)) {
+        __atomic_store_n(&a->reject, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    if (ec) {
+        MLDSA_NAMESPACE(poly_sparse_mul_s16)(h, &a->w->csp, &ec->t0.vec[i]);
+    } else {
+        challenge_mul(h, a->k, a->w, &e->t0.vec[i]);
+    }
+    PQCLEAN_MLDSA_CLEAN_poly_reduce(h);
+    if (PQCLEAN_MLDSA_CLEAN_poly_chknorm(h, GAMMA2)) {
+        __atomic_store_n(&a->reject, 1, __ATOMIC_RELAXED);
+    }
+}
+
+/* Source of rnd for every signature; NULL draws it from randombytes */
+static void (*rnd_hook)(uint8_t *rnd, size_t len) = NULL;
+
+/*************************************************
+* Name:        crypto_sign_set_rnd
+*
+* Description: Chooses where signing takes the per-signature randomness rnd
+*              from. NULL draws it from randombytes (hedged signing, the
+*              default); crypto_sign_rnd_deterministic makes it zero
+*              (deterministic signing of FIPS 204); any other function,
+*              such as a DRBG, is called once per signature. Entries of
+*              crypto_sign_presign do not depend on the message and keep
+*              drawing from randombytes. Takes effect from the next call.
+*
+* Arguments:   - fill: function writing len bytes of rnd, or NULL
+**************************************************/
+void MLDSA_NAMESPACE(crypto_sign_set_rnd)(void (*fill)(uint8_t *rnd, size_t len)) {
+    rnd_hook = fill;
+}
+
+/*************************************************
+* Name:        crypto_sign_rnd_deterministic
+*
+* Description: rnd source for crypto_sign_set_rnd giving deterministic
+*              signatures: rnd is all zero.
+**************************************************/
+void MLDSA_NAMESPACE(crypto_sign_rnd_deterministic)(uint8_t *rnd, size_t len) {
+    size_t i;
+
+    for (i = 0; i < len; ++i) {
+        rnd[i] = 0;
+    }
+}
+
+/*************************************************
+* Name:        mu_init
+*
+* Description: Starts mu = CRH(tr, 0, ctxlen, ctx, msg) by absorbing
+*              everything up to the message.
+*
+* Arguments:   - shake256incctx *state: state to initialize
+*              - uint8_t *tr:     hash of the public key
+*              - uint8_t *ctx:    pointer to context string
+*              - size_t ctxlen:   length of context string (at most 255)
+**************************************************/
+static void mu_init(shake256incctx *state, const uint8_t *tr,
+                    const uint8_t *ctx, size_t ctxlen) {
+    uint8_t pre[2] = {0, (uint8_t)ctxlen};
+
+    shake256_inc_init(state);
+    shake256_inc_absorb(state, tr, TRBYTES);
+    shake256_inc_absorb(state, pre, 2);
+    shake256_inc_absorb(state, ctx, ctxlen);
+}
+
+/*************************************************
+* Name:        sign_prepare
+*
+* Description: Squeezes mu = CRH(tr, 0, ctxlen, ctx, msg) from a state
+*              started by mu_init that has absorbed the message, draws
+*              rnd, and computes rhoprime = CRH(key, rnd, mu) into seedbuf,
+*              laid out as key | rnd | mu | rhoprime.
+*
+* Arguments:   - uint8_t *seedbuf: output buffer of
+*                                  SEEDBYTES + RNDBYTES + 2*CRHBYTES bytes
+*              - const esk_header *hd: header of the expanded secret key
+*              - shake256incctx *state: mu state, finalized here
+**************************************************/
+static void sign_prepare(uint8_t *seedbuf,
+                         const MLDSA_NAMESPACE(esk_header) *hd,
+                         shake256incctx *state) {
+    unsigned int i;
+    uint8_t *key = seedbuf;
+    uint8_t *rnd = key + SEEDBYTES;
+    uint8_t *mu = rnd + RNDBYTES;
+
+    shake256_inc_finalize(state);
+    shake256_inc_squeeze(mu, CRHBYTES, state);
+    shake256_inc_ctx_release(state);
+
+    /* key, rnd and mu are contiguous */
+    for (i = 0; i < SEEDBYTES; ++i) {
+        key[i] = hd->key[i];
+    }
+    if (rnd_hook != NULL) {
+        rnd_hook(rnd, RNDBYTES);
+    } else {
+        randombytes(rnd, RNDBYTES);
+    }
+    shake256(mu + CRHBYTES, CRHBYTES, seedbuf, SEEDBYTES + RNDBYTES + CRHBYTES);
+}
+
+/*************************************************
+* Name:        sign_mask_w
+*
+* Description: Samples y = ExpandMask(rhoprime, nonce) and computes
+*              w = A*y with coefficients in [0, Q), left in w->w1.
+*              A streamed matrix uses the h buffer for its rows, h is not
+*              needed until after the challenge.
+*
+* Arguments:   - const sign_key *k:    expanded secret key
+*              - sign_scratch *w:      scratch of this attempt
+*              - const uint8_t *rhoprime: mask seed, CRHBYTES
+*              - uint16_t nonce:       mask nonce
+*              - int par:              sample y over the fork-join hook
+**************************************************/
+static void sign_mask_w(const sign_key *k,
+                        MLDSA_NAMESPACE(sign_scratch) *w,
+                        const uint8_t *rhoprime,
+                        uint16_t nonce,
+                        int par) {
+    sign_par_args pargs = {k, w, rhoprime, nonce, 0};
+
+    /* Sample intermediate vector y */
+    if (par) {
+        MLDSA_NAMESPACE(par_for)(sign_par_mask, &pargs, L);
+    } else {
+        MLDSA_NAMESPACE(polyvecl_uniform_gamma1)(&w->y, rhoprime, nonce);
+        w->z = w->y;
+        MLDSA_NAMESPACE(polyvecl_ntt)(&w->z);
+    }
+
+    /* Matrix-vector multiplication */
+    if (k->mat) {
+        MLDSA_NAMESPACE(polyvec_matrix_pointwise_invntt_tomont)(&w->w1, k->mat, &w->z);
+    } else {
+        MLDSA_NAMESPACE(polyvec_matrix_stream_pointwise_montgomery)(&w->w1, &w->row, k->hd->rho, &w->z);
+        MLDSA_NAMESPACE(polyveck_invntt_tomont)(&w->w1);
+    }
+    MLDSA_NAMESPACE(polyveck_caddq)(&w->w1);
+}
+
+/*************************************************
+* Name:        sign_respond
+*
+* Description: Second half of an attempt: challenge and response for the
+*              commitment w1, w0 and mask y already in w.
+*
+* Arguments:   - const sign_key *k:    expanded secret key
+*              - sign_scratch *w:      y, w1 and w0 in; z and h out
+*              - const uint8_t *mu:    message representative, CRHBYTES
+*              - uint8_t *buf:         K*POLYW1_PACKEDBYTES bytes for the
+*                                      packed w1; holds c~ on return
+*              - int par:              spread the work over the fork-join hook
+*
+* Returns 0 if the attempt is accepted (signature in c~, w->z, w->h),
+* 1 if it is rejected
+**************************************************/
+static int sign_respond(const sign_key *k,
+                        MLDSA_NAMESPACE(sign_scratch) *w,
+                        const uint8_t *mu,
+                        uint8_t *buf,
+                        int par) {
+    polyveck *w1 = &w->w1;
+    polyveck *w0 = &w->w0;
+    polyveck *h = &w->h;
+    poly *cp = &w->cp;
+    unsigned int i, n;
+    shake256incctx state;
+    sign_par_args pargs = {k, w, NULL, 0, 0};
+
+    /* Call the random oracle */
+    MLDSA_NAMESPACE(polyveck_pack_w1)(buf, w1);
+
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, mu, CRHBYTES);
+    shake256_inc_absorb(&state, buf, K * POLYW1_PACKEDBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(buf, CTILDEBYTES, &state);
+    shake256_inc_ctx_release(&state);
+    if (k->sparse) {
+        MLDSA_NAMESPACE(poly_challenge_sparse)(&w->csp, buf);
+    } else {
+        MLDSA_NAMESPACE(poly_challenge)(cp, buf);
+        PQCLEAN_MLDSA_CLEAN_poly_ntt(cp);
+    }
+
+    /* Compute z, reject if it reveals secret. Then check that subtracting
+     * cs2 does not change high bits of w and low bits do not reveal secret
+     * information, and compute ct0 for the hints. */
+    if (par) {
+        MLDSA_NAMESPACE(par_for)(sign_par_response, &pargs, L + K);
+    } else {
+        for (i = 0; i < L + K && !pargs.reject; ++i) {
+            sign_par_response(&pargs, i);
+        }
+    }
+    if (pargs.reject) {
+        return 1;
+    }
+
+    MLDSA_NAMESPACE(polyveck_add)(w0, w0, h);
+    n = MLDSA_NAMESPACE(polyveck_make_hint)(h, w0, w1);
+    if (n > OMEGA) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/*************************************************
+* Name:        sign_attempt
+*
+* Description: One iteration of the rejection loop of signing.
+*
+* Arguments:   - const sign_key *k:    expanded secret key; A is regenerated
+*                                      row by row if k->mat is NULL
+*              - sign_scratch *w:      y, z, w1, w0, h and cp of this attempt
+*              - const uint8_t *mu:    message representative, CRHBYTES
+*              - const uint8_t *rhoprime: mask seed, CRHBYTES
+*              - uint16_t nonce:       mask nonce of this attempt
+*              - uint8_t *buf:         K*POLYW1_PACKEDBYTES bytes for the
+*                                      packed w1; holds c~ on return
+*              - int par:              spread the work over the fork-join hook
+*
+* Returns 0 if the attempt is accepted (signature in c~, w->z, w->h),
+* 1 if it is rejected
+**************************************************/
+static int sign_attempt(const sign_key *k,
+                        MLDSA_NAMESPACE(sign_scratch) *w,
+                        const uint8_t *mu,
+                        const uint8_t *rhoprime,
+                        uint16_t nonce,
+                        uint8_t *buf,
+                        int par) {
+    sign_par_args pargs = {k, w, rhoprime, nonce, 0};
+
+    if (par && k->mat) {
+        /* Same steps as sign_mask_w, spread over the fork-join hook */
+        MLDSA_NAMESPACE(par_for)(sign_par_mask, &pargs, L);
+        MLDSA_NAMESPACE(par_for)(sign_par_w, &pargs, K);
+    } else {
+        sign_mask_w(k, w, rhoprime, nonce, par);
+
+        /* Decompose w */
+        MLDSA_NAMESPACE(polyveck_decompose)(&w->w1, &w->w0, &w->w1);
+    }
+
+    return sign_respond(k, w, mu, buf, par);
+}
+
+/*************************************************
+* Name:        crypto_sign_init
+*
+* Description: Starts signing a message that is passed in pieces: hashes
+*              the key and context string so the message can follow
+*              through crypto_sign_update and be signed by one of the
+*              crypto_sign_final functions. Memory use does not depend on
+*              the message length.
+*
+* Arguments:   - void *st:       pointer to state of
+*                                CRYPTO_SIGN_STATEBYTES bytes,
+*                                aligned for uint64_t
+*              - uint8_t *ctx:   pointer to context string
+*              - size_t ctxlen:  length of context string
+*              - void *esk:      pointer to expanded key of any form; the
+*                                final call must use the same key
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_init_ctx_esk)(void *st,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const void *esk) {
+    const MLDSA_NAMESPACE(esk_header) *hd = esk;
+
+    if (ctxlen > 255) {
+        return -1;
+    }
+    mu_init(st, hd->tr, ctx, ctxlen);
+    return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_update
+*
+* Description: Appends a piece of the message to a state from
+*              crypto_sign_init.
+*
+* Arguments:   - void *st:       pointer to signing state
+*              - uint8_t *m:     pointer to next piece of the message
+*              - size_t mlen:    length of that piece
+*
+* Returns 0 (success)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_update)(void *st, const uint8_t *m, size_t mlen) {
+    shake256_inc_absorb(st, m, mlen);
+    return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_final_esk
+*
+* Description: Computes signature of the message absorbed into st, which
+*              is used up. Performs no heap allocation.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - void *st:       pointer to signing state
+*              - void *esk:      pointer to the key passed to crypto_sign_init
+*              - void *ws:       pointer to workspace of at least
+*                                CRYPTO_ESK_WORKSPACEBYTES bytes,
+*                                aligned for uint32_t
+*
+* Returns 0 (success)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_final_esk)(uint8_t *sig,
+        size_t *siglen,
+        void *st,
+        const void *esk,
+        void *ws) {
+    sign_key key;
+    MLDSA_NAMESPACE(sign_scratch) *w = ws;
+    const uint8_t *mu = w->seedbuf + SEEDBYTES + RNDBYTES;
+    const uint8_t *rhoprime = mu + CRHBYTES;
+    uint16_t nonce = 0;
+
+    sign_key_init(&key, esk);
+    sign_prepare(w->seedbuf, key.hd, st);
+
+    while (sign_attempt(&key, w, mu, rhoprime, nonce++, sig,
+                        MLDSA_NAMESPACE(par_enabled)())) {
+    }
+
+    /* Write signature */
+    MLDSA_NAMESPACE(pack_sig)(sig, sig, &w->z, &w->h);
+    *siglen = CRYPTO_BYTES;
+
+    return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_esk
+*
+* Description: Computes signature from an expanded secret key.
+*              Performs no heap allocation.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *m:     pointer to message to be signed
+*              - size_t mlen:    length of message
+*              - uint8_t *ctx:   pointer to context string
+*              - size_t ctxlen:  length of context string
+*              - void *esk:      pointer to key from crypto_sign_expand_sk,
+*                                crypto_sign_expand_sk_stream or
+*                                crypto_sign_expand_sk_compact
+*              - void *ws:       pointer to workspace of at least
+*                                CRYPTO_ESK_WORKSPACEBYTES bytes,
+*                                aligned for uint32_t
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_signature_ctx_esk)(uint8_t *sig,
+        size_t *siglen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const void *esk,
+        void *ws) {
+    shake256incctx state;
+
+    if (MLDSA_NAMESPACE(crypto_sign_init_ctx_esk)(&state, ctx, ctxlen, esk)) {
+        return -1;
+    }
+    shake256_inc_absorb(&state, m, mlen);
+    return MLDSA_NAMESPACE(crypto_sign_final_esk)(sig, siglen, &state, esk, ws);
+}
+
+/* One speculative attempt per fork-join index */
+typedef struct {
+    const sign_key *k;
+    MLDSA_NAMESPACE(sign_scratch) *w;
+    const uint8_t *mu;
+    const uint8_t *rhoprime;
+    uint8_t *buf;
+    uint16_t nonce;
+    int ret;
+} sign_spec_args;
+
+static void sign_spec_attempt(void *arg, unsigned int i) {
+    sign_spec_args *a = (sign_spec_args *)arg + i;
+    a->ret = sign_attempt(a->k, a->w, a->mu, a->rhoprime, a->nonce, a->buf, 0);
+}
+
+/*************************************************
+* Name:        crypto_sign_final_esk_spec
+*
+* Description: Computes signature of the message absorbed into st like
+*              crypto_sign_final_esk, evaluating two consecutive nonces at
+*              once through the fork-join hook. The lower accepted nonce
+*              wins, so the signature is the same as crypto_sign_final_esk
+*              for the same randomness. Without a hook it behaves exactly
+*              like that function. Performs no heap allocation.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - void *st:       pointer to signing state
+*              - void *esk:      pointer to the key passed to crypto_sign_init
+*              - void *ws:       pointer to workspace of at least
+*                                CRYPTO_ESK_SPEC_WORKSPACEBYTES bytes,
+*                                aligned for uint32_t
+*
+* Returns 0 (success)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_final_esk_spec)(uint8_t *sig,
+        size_t *siglen,
+        void *st,
+        const void *esk,
+        void *ws) {
+    sign_key key;
+    MLDSA_NAMESPACE(sign_scratch) *w = ws;
+    const uint8_t *mu = w[0].seedbuf + SEEDBYTES + RNDBYTES;
+    const uint8_t *rhoprime = mu + CRHBYTES;
+    sign_spec_args args[2];
+    unsigned int i, j;
+    uint16_t nonce;
+
+    if (!MLDSA_NAMESPACE(par_enabled)()) {
+        return MLDSA_NAMESPACE(crypto_sign_final_esk)(sig, siglen, st, esk, ws);
+    }
+
+    sign_key_init(&key, esk);
+    sign_prepare(w[0].seedbuf, key.hd, st);
+
+    /* Both attempts pack w1 into disjoint parts of sig */
+    for (j = 0; j < 2; ++j) {
+        args[j].k = &key;
+        args[j].w = &w[j];
+        args[j].mu = mu;
+        args[j].rhoprime = rhoprime;
+        args[j].buf = sig + j * K * POLYW1_PACKEDBYTES;
+    }
+
+    for (nonce = 0;; nonce += 2) {
+        args[0].nonce = nonce;
+        args[1].nonce = (uint16_t)(nonce + 1);
+        MLDSA_NAMESPACE(par_for)(sign_spec_attempt, args, 2);
+        if (args[0].ret == 0) {
+            j = 0;
+            break;
+        }
+        if (args[1].ret == 0) {
+            j = 1;
+            break;
+        }
+    }
+
+    for (i = 0; i < CTILDEBYTES; ++i) {
+        sig[i] = args[j].buf[i];
+    }
+
+    /* Write signature */
+    MLDSA_NAMESPACE(pack_sig)(sig, sig, &w[j].z, &w[j].h);
+    *siglen = CRYPTO_BYTES;
+
+    return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_esk_spec
+*
+* Description: Computes signature from an expanded secret key, evaluating
+*              two consecutive nonces at once through the fork-join hook;
+*              see crypto_sign_final_esk_spec. Performs no heap allocation.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *m:     pointer to message to be signed
+*              - size_t mlen:    length of message
+*              - uint8_t *ctx:   pointer to context string
+*              - size_t ctxlen:  length of context string
+*              - void *esk:      pointer to key from crypto_sign_expand_sk,
+*                                crypto_sign_expand_sk_stream or
+*                                crypto_sign_expand_sk_compact
+*              - void *ws:       pointer to workspace of at least
+*                                CRYPTO_ESK_SPEC_WORKSPACEBYTES bytes,
+*                                aligned for uint32_t
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_signature_ctx_esk_spec)(uint8_t *sig,
+        size_t *siglen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const void *esk,
+        void *ws) {
+    shake256incctx state;
+
+    if (MLDSA_NAMESPACE(crypto_sign_init_ctx_esk)(&state, ctx, ctxlen, esk)) {
+        return -1;
+    }
+    shake256_inc_absorb(&state, m, mlen);
+    return MLDSA_NAMESPACE(crypto_sign_final_esk_spec)(sig, siglen, &state, esk, ws);
+}
+
+/*************************************************
+* Name:        crypto_sign_presign
+*
+* Description: Precomputes the message-independent part of one signing
+*              attempt: a fresh mask seed rhoprime = CRH(key, rnd) and
+*              w = A*y for y = ExpandMask(rhoprime, 0). Unlike FIPS 204,
+*              y then does not depend on mu; the signature is still valid,
+*              but the entry must stay secret and be used only once, as
+*              crypto_sign_signature_esk_pre does. Does not use the
+*              fork-join hook. Performs no heap allocation.
+*
+* Arguments:   - void *pre:      pointer to output entry of at least
+*                                CRYPTO_PRESIGBYTES bytes,
+*                                aligned for uint32_t
+*              - void *esk:      pointer to expanded key of any form
+*              - void *ws:       pointer to workspace of at least
+*                                CRYPTO_ESK_WORKSPACEBYTES bytes,
+*                                aligned for uint32_t
+*
+* Returns 0 (success)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_presign)(void *pre, const void *esk, void *ws) {
+    MLDSA_NAMESPACE(presig) *p = pre;
+    MLDSA_NAMESPACE(sign_scratch) *w = ws;
+    sign_key key;
+    unsigned int i;
+
+    sign_key_init(&key, esk);
+    for (i = 0; i < SEEDBYTES; ++i) {
+        w->seedbuf[i] = key.hd->key[i];
+    }
+    randombytes(w->seedbuf + SEEDBYTES, RNDBYTES);
+    shake256(p->rhoprime, CRHBYTES, w->seedbuf, SEEDBYTES + RNDBYTES);
+
+    sign_mask_w(&key, w, p->rhoprime, 0, 0);
+    p->w = w->w1;
+
+    return 0;
+}
+
+/* Clears a consumed entry; volatile so the stores are not dropped */
+static void presig_wipe(MLDSA_NAMESPACE(presig) *p) {
+    volatile uint8_t *b = (volatile uint8_t *)p;
+    size_t i;
+
+    for (i = 0; i < sizeof(*p); ++i) {
+        b[i] = 0;
+    }
+}
+
+/*************************************************
+* Name:        crypto_sign_final_esk_pre
+*
+* Description: Computes signature of the message absorbed into st, taking
+*              the first attempts from entries of crypto_sign_presign. Each
+*              of those attempts only hashes and computes the response.
+*              Entries are used from the last one down and wiped as they
+*              are consumed; once none are left, signing continues as
+*              crypto_sign_final_esk does.
+*              Performs no heap allocation.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - void *st:       pointer to signing state
+*              - void *esk:      pointer to the key passed to crypto_sign_init,
+*                                which the entries were made for
+*              - void *pre:      pointer to array of *npre entries
+*              - size_t *npre:   number of entries; on return the number left
+*              - void *ws:       pointer to workspace of at least
+*                                CRYPTO_ESK_WORKSPACEBYTES bytes,
+*                                aligned for uint32_t
+*
+* Returns 0 (success)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_final_esk_pre)(uint8_t *sig,
+        size_t *siglen,
+        void *st,
+        const void *esk,
+        void *pre,
+        size_t *npre,
+        void *ws) {
+    sign_key key;
+    MLDSA_NAMESPACE(presig) *p;
+    MLDSA_NAMESPACE(sign_scratch) *w = ws;
+    const uint8_t *mu = w->seedbuf + SEEDBYTES + RNDBYTES;
+    const uint8_t *rhoprime = mu + CRHBYTES;
+    int par = MLDSA_NAMESPACE(par_enabled)();
+    int rejected = 1;
+    uint16_t nonce = 0;
+
+    sign_key_init(&key, esk);
+    sign_prepare(w->seedbuf, key.hd, st);
+
+    while (rejected && *npre > 0) {
+        p = (MLDSA_NAMESPACE(presig) *)pre + --*npre;
+        MLDSA_NAMESPACE(polyvecl_uniform_gamma1)(&w->y, p->rhoprime, 0);
+        MLDSA_NAMESPACE(polyveck_decompose)(&w->w1, &w->w0, &p->w);
+        presig_wipe(p);
+        rejected = sign_respond(&key, w, mu, sig, par);
+    }
+    while (rejected) {
+        rejected = sign_attempt(&key, w, mu, rhoprime, nonce++, sig, par);
+    }
+
+    /* Write signature */
+    MLDSA_NAMESPACE(pack_sig)(sig, sig, &w->z, &w->h);
+    *siglen = CRYPTO_BYTES;
+
+    return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_esk_pre
+*
+* Description: Computes signature from an expanded secret key, taking the
+*              first attempts from entries of crypto_sign_presign; see
+*              crypto_sign_final_esk_pre. Performs no heap allocation.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *m:     pointer to message to be signed
+*              - size_t mlen:    length of message
+*              - uint8_t *ctx:   pointer to context string
+*              - size_t ctxlen:  length of context string
+*              - void *esk:      pointer to expanded key the entries were made for
+*              - void *pre:      pointer to array of *npre entries
+*              - size_t *npre:   number of entries; on return the number left
+*              - void *ws:       pointer to workspace of at least
+*                                CRYPTO_ESK_WORKSPACEBYTES bytes,
+*                                aligned for uint32_t
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_signature_ctx_esk_pre)(uint8_t *sig,
+        size_t *siglen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const void *esk,
+        void *pre,
+        size_t *npre,
+        void *ws) {
+    shake256incctx state;
+
+    if (MLDSA_NAMESPACE(crypto_sign_init_ctx_esk)(&state, ctx, ctxlen, esk)) {
+        return -1;
+    }
+    shake256_inc_absorb(&state, m, mlen);
+    return MLDSA_NAMESPACE(crypto_sign_final_esk_pre)(sig, siglen, &state, esk, pre, npre, ws);
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_batch
+*
+* Description: Signs n messages under one expanded secret key, in order.
+*              Batching only amortizes the key setup and the context
+*              checks; every message is hashed and goes through its own
+*              rejection loop, so the cost per signature is otherwise that
+*              of crypto_sign_signature_esk. Consumes randomness as n such
+*              calls would, so the signatures are the same.
+*              Performs no heap allocation.
+*
+* Arguments:   - uint8_t *sigs[]:   n output buffers of CRYPTO_BYTES each
+*              - size_t siglens[]:  n output lengths
+*              - uint8_t *msgs[]:   n messages to be signed
+*              - size_t mlens[]:    n message lengths
+*              - size_t n:          number of messages
+*              - uint8_t *ctx:      pointer to context string, shared by all
+*              - size_t ctxlen:     length of context string
+*              - void *esk:         pointer to expanded key of any form
+*              - void *ws:          pointer to workspace of at least
+*                                   CRYPTO_BATCH_WORKSPACEBYTES bytes,
+*                                   aligned for uint32_t
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_signature_ctx_batch)(uint8_t *const sigs[],
+        size_t siglens[],
+        const uint8_t *const msgs[],
+        const size_t mlens[],
+        size_t n,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const void *esk,
+        void *ws) {
+    if (ctxlen > 255) {
+        return -1;
+    }
+
+    MLDSA_NAMESPACE(sign_scratch) *w = ws;
+    const uint8_t *mu = w->seedbuf + SEEDBYTES + RNDBYTES;
+    const uint8_t *rhoprime = mu + CRHBYTES;
+    sign_key key;
+    shake256incctx mst;
+    int par = MLDSA_NAMESPACE(par_enabled)();
+    size_t i;
+    uint16_t nonce;
+
+    sign_key_init(&key, esk);
+
+    for (i = 0; i < n; ++i) {
+        mu_init(&mst, key.hd->tr, ctx, ctxlen);
+        shake256_inc_absorb(&mst, msgs[i], mlens[i]);
+        sign_prepare(w->seedbuf, key.hd, &mst);
+
+        nonce = 0;
+        while (sign_attempt(&key, w, mu, rhoprime, nonce++, sigs[i], par)) {
+        }
+
+        /* Write signature */
+        MLDSA_NAMESPACE(pack_sig)(sigs[i], sigs[i], &w->z, &w->h);
+        siglens[i] = CRYPTO_BYTES;
+    }
+
+    return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_ws
+*
+* Description: Computes signature using a caller-supplied workspace.
+*              Performs no heap allocation.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *m:     pointer to message to be signed
+*              - size_t mlen:    length of message
+*              - uint8_t *ctx:   pointer to context string
+*              - size_t ctxlen:  length of context string
+*              - uint8_t *sk:    pointer to bit-packed secret key
+*              - void *ws:       pointer to workspace of at least
+*                                CRYPTO_WORKSPACEBYTES bytes,
+*                                aligned for uint32_t
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_signature_ctx_ws)(uint8_t *sig,
+        size_t *siglen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const uint8_t *sk,
+        void *ws) {
+    MLDSA_NAMESPACE(workspace) *w = ws;
+
+    if (ctxlen > 255) {
+        return -1;
+    }
+
+    MLDSA_NAMESPACE(crypto_sign_expand_sk)(&w->sign.esk, sk);
+    return MLDSA_NAMESPACE(crypto_sign_signature_ctx_esk)(sig, siglen, m, mlen, ctx, ctxlen,
+            &w->sign.esk, &w->sign.scratch);
+}
+
+/*************************************************
+* Name:        crypto_sign_signature
+*
+* Description: Computes signature. Allocates a workspace on the heap
+*              for the duration of the call.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *m:     pointer to message to be signed
+*              - size_t mlen:    length of message
+*              - uint8_t *ctx:   pointer to context string
+*              - size_t ctxlen:  length of context string
+*              - uint8_t *sk:    pointer to bit-packed secret key
+*
+* Returns 0 (success) or -1 (context string too long or out of memory)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_signature_ctx)(uint8_t *sig,
+        size_t *siglen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const uint8_t *sk) {
+    int ret;
+    MLDSA_NAMESPACE(workspace) *ws = malloc(sizeof(MLDSA_NAMESPACE(workspace)));
+    if (ws == NULL) {
+        printf("Failed to allocate memory for signing workspace\n");
+        return -1;
+    }
+
+    ret = MLDSA_NAMESPACE(crypto_sign_signature_ctx_ws)(sig, siglen, m, mlen, ctx, ctxlen, sk, ws);
+    free(ws);
+    return ret;
+}
+
+
+/*************************************************
+* Name:        crypto_sign
+*
+* Description: Compute signed message.
+*
+* Arguments:   - uint8_t *sm: pointer to output signed message (allocated
+*                             array with CRYPTO_BYTES + mlen bytes),
+*                             can be equal to m
+*              - size_t *smlen: pointer to output length of signed
+*                               message
+*              - const uint8_t *m: pointer to message to be signed
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *sk: pointer to bit-packed secret key
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_ctx)(uint8_t *sm,
+        size_t *smlen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const uint8_t *sk) {
+    int ret;
+    size_t i;
+
+    for (i = 0; i < mlen; ++i) {
+        sm[CRYPTO_BYTES + mlen - 1 - i] = m[mlen - 1 - i];
+    }
+    ret = MLDSA_NAMESPACE(crypto_sign_signature_ctx)(sm, smlen, sm + CRYPTO_BYTES, mlen, ctx, ctxlen, sk);
+    *smlen += mlen;
+    return ret;
+}
+
+/*************************************************
+* Name:        verify_mu
+*
+* Description: Computes mu = CRH(tr, 0, ctxlen, ctx, msg). tr may alias mu.
+**************************************************/
+static void verify_mu(uint8_t mu[CRHBYTES], const uint8_t *tr,
+                      const uint8_t *m, size_t mlen,
+                      const uint8_t *ctx, size_t ctxlen) {
+    shake256incctx state;
+
+    mu_init(&state, tr, ctx, ctxlen);
+    shake256_inc_absorb(&state, m, mlen);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(mu, CRHBYTES, &state);
+    shake256_inc_ctx_release(&state);
+}
+
+/*************************************************
+* Name:        verify_finish
+*
+* Description: Last steps of verification once v->w1 holds A*z and v->t1
+*              holds c*t1*2^d, both in NTT domain: recovers w1 from the
+*              hint and compares the challenge against H(mu, w1).
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+static int verify_finish(MLDSA_NAMESPACE(verify_scratch) *v) {
+    polyveck *w1 = &v->w1;
+    unsigned int i;
+    shake256incctx state;
+
+    MLDSA_NAMESPACE(polyveck_sub)(w1, w1, &v->t1);
+    MLDSA_NAMESPACE(polyveck_reduce)(w1);
+    MLDSA_NAMESPACE(polyveck_invntt_tomont)(w1);
+
+    /* Reconstruct w1 */
+    MLDSA_NAMESPACE(polyveck_caddq)(w1);
+    MLDSA_NAMESPACE(polyveck_use_hint)(w1, w1, &v->h);
+    MLDSA_NAMESPACE(polyveck_pack_w1)(v->buf, w1);
+
+    /* Call random oracle and verify challenge */
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, v->mu, CRHBYTES);
+    shake256_inc_absorb(&state, v->buf, K * POLYW1_PACKEDBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(v->c2, CTILDEBYTES, &state);
+    shake256_inc_ctx_release(&state);
+
+    for (i = 0; i < CTILDEBYTES; ++i) {
+        if (v->c[i] != v->c2[i]) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/*************************************************
+* Name:        verify_internal
+*
+* Description: Verification proper, shared by the full and the streaming
+*              workspace layouts.
+*
+* Arguments:   - verify_scratch *v: verification state
+*              - polyvecl *mat:     K rows for the expanded matrix A, or with
+*                                   stream set a single row buffer
+*              - int stream:        regenerate A row by row from rho
+*              - remaining arguments as for crypto_sign_verify_ws
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+static int verify_internal(const uint8_t *sig,
+                           const uint8_t *m,
+                           size_t mlen,
+                           const uint8_t *ctx,
+                           size_t ctxlen,
+                           const uint8_t *pk,
+                           MLDSA_NAMESPACE(verify_scratch) *v,
+                           polyvecl *mat,
+                           int stream) {
+    uint8_t *rho = v->rho;
+    uint8_t *mu = v->mu;
+    uint8_t *c = v->c;
+    poly *cp = &v->cp;
+    polyvecl *z = &v->z;
+    polyveck *t1 = &v->t1;
+    polyveck *w1 = &v->w1;
+    polyveck *h = &v->h;
+
+    MLDSA_NAMESPACE(unpack_pk)(rho, t1, pk);
+    if (MLDSA_NAMESPACE(unpack_sig)(c, z, h, sig)) {
+        return -1;
+    }
+    if (MLDSA_NAMESPACE(polyvecl_chknorm)(z, GAMMA1 - BETA)) {
+        return -1;
+    }
+
+    /* Compute CRH(H(rho, t1), msg) */
+    shake256(mu, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+    verify_mu(mu, mu, m, mlen, ctx, ctxlen);
+
+    /* Matrix-vector multiplication; compute Az - c2^dt1 */
+    MLDSA_NAMESPACE(poly_challenge)(cp, c);
+    MLDSA_NAMESPACE(polyvecl_ntt)(z);
+    if (stream) {
+        MLDSA_NAMESPACE(polyvec_matrix_stream_pointwise_montgomery)(w1, mat, rho, z);
+    } else {
+        MLDSA_NAMESPACE(polyvec_matrix_expand)(mat, rho);
+        MLDSA_NAMESPACE(polyvec_matrix_pointwise_montgomery)(w1, mat, z);
+    }
+
+    PQCLEAN_MLDSA_CLEAN_poly_ntt(cp);
+    MLDSA_NAMESPACE(polyveck_shiftl)(t1);
+    MLDSA_NAMESPACE(polyveck_ntt)(t1);
+    MLDSA_NAMESPACE(polyveck_pointwise_poly_montgomery)(t1, cp, t1);
+
+    return verify_finish(v);
+}
+
+/*************************************************
+* Name:        crypto_sign_expand_pk
+*
+* Description: Expands a public key for repeated verification: tr = H(pk),
+*              the matrix A in NTT domain and NTT(t1*2^d). Verification
+*              against the expanded key skips all per-key work.
+*
+* Arguments:   - void *epk:        pointer to output expanded key of
+*                                  CRYPTO_EXPANDEDPKBYTES bytes,
+*                                  aligned for uint32_t
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 (success)
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_expand_pk)(void *epk, const uint8_t *pk) {
+    MLDSA_NAMESPACE(expanded_pk) *e = epk;
+
+    MLDSA_NAMESPACE(unpack_pk)(e->rho, &e->t1, pk);
+    shake256(e->tr, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+    MLDSA_NAMESPACE(polyvec_matrix_expand)(e->mat, e->rho);
+    MLDSA_NAMESPACE(polyveck_shiftl)(&e->t1);
+    MLDSA_NAMESPACE(polyveck_ntt)(&e->t1);
+
+    return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_epk
+*
+* Description: Verifies signature against a public key expanded by
+*              crypto_sign_expand_pk. Performs no heap allocation.
+*
+* Arguments:   - uint8_t *sig: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const void *epk: pointer to expanded public key
+*              - void *ws: pointer to workspace of at least
+*                          CRYPTO_VERIFY_EPK_WORKSPACEBYTES bytes,
+*                          aligned for uint32_t
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_verify_ctx_epk)(const uint8_t *sig,
+        size_t siglen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const void *epk,
+        void *ws) {
+    const MLDSA_NAMESPACE(expanded_pk) *e = epk;
+    MLDSA_NAMESPACE(verify_scratch) *v = ws;
+
+    if (ctxlen > 255 || siglen != CRYPTO_BYTES) {
+        return -1;
+    }
+    if (MLDSA_NAMESPACE(unpack_sig)(v->c, &v->z, &v->h, sig)) {
+        return -1;
+    }
+    if (MLDSA_NAMESPACE(polyvecl_chknorm)(&v->z, GAMMA1 - BETA)) {
+        return -1;
+    }
+
+    verify_mu(v->mu, e->tr, m, mlen, ctx, ctxlen);
+
+    /* Matrix-vector multiplication; compute Az - c2^dt1 */
+    MLDSA_NAMESPACE(poly_challenge)(&v->cp, v->c);
+    MLDSA_NAMESPACE(polyvecl_ntt)(&v->z);
+    MLDSA_NAMESPACE(polyvec_matrix_pointwise_montgomery)(&v->w1, e->mat, &v->z);
+
+    PQCLEAN_MLDSA_CLEAN_poly_ntt(&v->cp);
+    MLDSA_NAMESPACE(polyveck_pointwise_poly_montgomery)(&v->t1, &v->cp, &e->t1);
+
+    return verify_finish(v);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_batch
+*
+* Description: Verifies n signatures under one public key, which is
+*              expanded once for the whole batch. Allocates a single
+*              workspace on the heap for the duration of the call.
+*
+* Arguments:   - uint8_t *sigs[]:   n input signatures
+*              - size_t siglens[]:  n signature lengths
+*              - uint8_t *msgs[]:   n messages
+*              - size_t mlens[]:    n message lengths
+*              - size_t n:          number of signatures
+*              - uint8_t *ctx:      pointer to context string, shared by all
+*              - size_t ctxlen:     length of context string
+*              - uint8_t *pk:       pointer to bit-packed public key
+*              - uint8_t *ok:       output bitmap of (n + 7)/8 bytes; bit
+*                                   i % 8 of ok[i / 8] is set iff
+*                                   signature i verifies
+*
+* Returns 0 if all signatures could be verified correctly and -1 otherwise
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_verify_ctx_batch)(const uint8_t *const sigs[],
+        const size_t siglens[],
+        const uint8_t *const msgs[],
+        const size_t mlens[],
+        size_t n,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const uint8_t *pk,
+        uint8_t *ok) {
+    MLDSA_NAMESPACE(verify_batch_workspace) *ws;
+    size_t i;
+    int ret = 0;
+
+    for (i = 0; i < (n + 7) / 8; ++i) {
+        ok[i] = 0;
+    }
+
+    ws = malloc(sizeof(MLDSA_NAMESPACE(verify_batch_workspace)));
+    if (ws == NULL) {
+        printf("Failed to allocate memory for batch verification workspace\n");
+        return -1;
+    }
+
+    MLDSA_NAMESPACE(crypto_sign_expand_pk)(&ws->epk, pk);
+    for (i = 0; i < n; ++i) {
+        if (MLDSA_NAMESPACE(crypto_sign_verify_ctx_epk)(sigs[i], siglens[i], msgs[i], mlens[i],
+                ctx, ctxlen, &ws->epk, &ws->v)) {
+            ret = -1;
+        } else {
+            ok[i / 8] |= (uint8_t)(1 << (i % 8));
+        }
+    }
+
+    free(ws);
+    return ret;
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_ws
+*
+* Description: Verifies signature using a caller-supplied workspace.
+*              Performs no heap allocation.
+*
+* Arguments:   - uint8_t *m: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*              - void *ws: pointer to workspace of at least
+*                          CRYPTO_WORKSPACEBYTES bytes,
+*                          aligned for uint32_t
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_verify_ctx_ws)(const uint8_t *sig,
+        size_t siglen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const uint8_t *pk,
+        void *ws) {
+    MLDSA_NAMESPACE(workspace) *w = ws;
+
+    if (ctxlen > 255 || siglen != CRYPTO_BYTES) {
+        return -1;
+    }
+    return verify_internal(sig, m, mlen, ctx, ctxlen, pk, &w->verify.v, w->verify.mat, 0);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_stream_ws
+*
+* Description: Verifies signature like crypto_sign_verify_ws, regenerating
+*              matrix A row by row instead of expanding it, which cuts the
+*              workspace by (K-1)*L polynomials. Performs no heap allocation.
+*
+* Arguments:   - uint8_t *m: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*              - void *ws: pointer to workspace of at least
+*                          CRYPTO_VERIFY_STREAM_WORKSPACEBYTES bytes,
+*                          aligned for uint32_t
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_verify_ctx_stream_ws)(const uint8_t *sig,
+        size_t siglen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const uint8_t *pk,
+        void *ws) {
+    MLDSA_NAMESPACE(verify_stream_workspace) *w = ws;
+
+    if (ctxlen > 255 || siglen != CRYPTO_BYTES) {
+        return -1;
+    }
+    return verify_internal(sig, m, mlen, ctx, ctxlen, pk, &w->v, &w->row, 1);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify
+*
+* Description: Verifies signature. Allocates a workspace on the heap
+*              for the duration of the call.
+*
+* Arguments:   - uint8_t *m: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_verify_ctx)(const uint8_t *sig,
+        size_t siglen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const uint8_t *pk) {
+    int ret;
+    MLDSA_NAMESPACE(workspace) *ws = malloc(sizeof(MLDSA_NAMESPACE(workspace)));
+    if (ws == NULL) {
+        printf("Failed to allocate memory for verification workspace\n");
+        return -1;
+    }
+
+    ret = MLDSA_NAMESPACE(crypto_sign_verify_ctx_ws)(sig, siglen, m, mlen, ctx, ctxlen, pk, ws);
+    free(ws);
+    return ret;
+}
+
+
+/*************************************************
+* Name:        crypto_sign_open
+*
+* Description: Verify signed message.
+*
+* Arguments:   - uint8_t *m: pointer to output message (allocated
+*                            array with smlen bytes), can be equal to sm
+*              - size_t *mlen: pointer to output length of message
+*              - const uint8_t *sm: pointer to signed message
+*              - size_t smlen: length of signed message
+*              - const uint8_t *ctx: pointer to context tring
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 if signed message could be verified correctly and -1 otherwise
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_open_ctx)(uint8_t *m,
+        size_t *mlen,
+        const uint8_t *sm,
+        size_t smlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const uint8_t *pk) {
+    size_t i;
+
+    if (smlen < CRYPTO_BYTES) {
+        goto badsig;
+    }
+
+    *mlen = smlen - CRYPTO_BYTES;
+    if (MLDSA_NAMESPACE(crypto_sign_verify_ctx)(sm, CRYPTO_BYTES, sm + CRYPTO_BYTES, *mlen, ctx, ctxlen, pk)) {
+        goto badsig;
+    } else {
+        /* All good, copy msg, return 0 */
+        for (i = 0; i < *mlen; ++i) {
+            m[i] = sm[CRYPTO_BYTES + i];
+        }
+        return 0;
+    }
+
+badsig:
+    /* Signature verification failed */
+    *mlen = 0;
+    for (i = 0; i < smlen; ++i) {
+        m[i] = 0;
+    }
+
+    return -1;
+}
+
+/* Fixed rnd of the hedged known-answer test */
+static void kat_rnd(uint8_t *rnd, size_t len) {
+    size_t i;
+
+    for (i = 0; i < len; ++i) {
+        rnd[i] = (uint8_t)(0x80 + i);
+    }
+}
+
+/*************************************************
+* Name:        crypto_sign_kat
+*
+* Description: Known-answer self-test of key generation from a seed and of
+*              signing, once deterministic (rnd = 0) and once hedged with
+*              a fixed rnd. Both signatures must also verify. Switches the
+*              rnd source while it runs, so call it before signing starts.
+*              Allocates a workspace on the heap for the duration of the
+*              call.
+*
+* Returns 0 on success, -1 on mismatch or if out of memory
+**************************************************/
+int MLDSA_NAMESPACE(crypto_sign_kat)(void) {
+    static const uint8_t msg[] = "SleeQC known-answer test";
+    static const uint8_t expected[2][16] = {SIGN_KAT_DETERMINISTIC, SIGN_KAT_HEDGED};
+    struct {
+        MLDSA_NAMESPACE(workspace) w;
+        uint8_t seed[SEEDBYTES];
+        uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+        uint8_t sk[CRYPTO_SECRETKEYBYTES];
+        uint8_t sig[2][CRYPTO_BYTES];
+    } *k;
+    void (*saved)(uint8_t *rnd, size_t len) = rnd_hook;
+    uint8_t h[16];
+    size_t siglen;
+    unsigned int i, j;
+    int ret = 0;
+
+    k = malloc(sizeof(*k));
+    if (k == NULL) {
+        return -1;
+    }
+
+    for (i = 0; i < SEEDBYTES; ++i) {
+        k->seed[i] = (uint8_t)i;
+    }
+    MLDSA_NAMESPACE(crypto_sign_seed_keypair_ws)(k->pk, k->sk, k->seed, &k->w);
+    MLDSA_NAMESPACE(crypto_sign_expand_sk)(&k->w.sign.esk, k->sk);
+
+    for (j = 0; j < 2; ++j) {
+        rnd_hook = j ? kat_rnd : MLDSA_NAMESPACE(crypto_sign_rnd_deterministic);
+        MLDSA_NAMESPACE(crypto_sign_signature_ctx_esk)(k->sig[j], &siglen, msg, sizeof(msg) - 1,
+                NULL, 0, &k->w.sign.esk, &k->w.sign.scratch);
+        shake256(h, sizeof(h), k->sig[j], siglen);
+        for (i = 0; i < sizeof(h); ++i) {
+            ret |= h[i] ^ expected[j][i];
+        }
+    }
+    rnd_hook = saved;
+
+    for (j = 0; j < 2; ++j) {
+        ret |= MLDSA_NAMESPACE(crypto_sign_verify_ctx_ws)(k->sig[j], CRYPTO_BYTES,
+                msg, sizeof(msg) - 1, NULL, 0, k->pk, &k->w);
+    }
+
+    free(k);
+    return ret ? -1 : 0;
+}
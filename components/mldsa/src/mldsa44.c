@@ -0,0 +1,9 @@
+/* ML-DSA-44: the per-level sources compiled with its parameter set */
+#define MLDSA_LEVEL 44
+
+#include "level/parallel.c"
+#include "level/rounding.c"
+#include "level/poly.c"
+#include "level/polyvec.c"
+#include "level/packing.c"
+#include "level/sign.c"
@@ -0,0 +1,9 @@
+/* ML-DSA-65: the per-level sources compiled with its parameter set */
+#define MLDSA_LEVEL 65
+
+#include "level/parallel.c"
+#include "level/rounding.c"
+#include "level/poly.c"
+#include "level/polyvec.c"
+#include "level/packing.c"
+#include "level/sign.c"
@@ -0,0 +1,350 @@
+#include "ntt.h"
+#include "params.h"
+#include "reduce.h"
+#include <stdint.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+/* The transforms run K*L times per signature, keep them out of flash */
+#define NTT_IRAM IRAM_ATTR
+#else
+#define NTT_IRAM
+#endif
+
+/* NTT backend selection.
+ * 0: the reference, one pass over the array per layer and a full 64-bit
+ *    Montgomery reduction per butterfly.
+ * 1: two layers per pass with four coefficients held in registers, and
+ *    butterflies that multiply by precomputed zeta*QINV so the Montgomery
+ *    step needs three 32x32 multiplies and no 64-bit subtraction. The
+ *    inverse folds its final scaling into the last pass.
+ * Both produce bit-identical output. Override with -DPQC_NTT_OPT=n. */
+#ifndef PQC_NTT_OPT
+#define PQC_NTT_OPT 1
+#endif
+
+static const int32_t zetas[N] = {
+    0,    25847, -2608894, -518909,   237124, -777960, -876248,   466468,
+    1826347,  2353451, -359251, -2091905,  3119733, -2884855,  3111497,  2680103,
+    2725464,  1024112, -1079900,  3585928, -549488, -1119584,  2619752, -2108549,
+    -2118186, -3859737, -1399561, -3277672,  1757237, -19422,  4010497,   280005,
+    2706023,    95776,  3077325,  3530437, -1661693, -3592148, -2537516,  3915439,
+    -3861115, -3043716,  3574422, -2867647,  3539968, -300467,  2348700, -539299,
+    -1699267, -1643818,  3505694, -3821735,  3507263, -2140649, -1600420,  3699596,
+    811944,   531354,   954230,  3881043,  3900724, -2556880,  2071892, -2797779,
+    -3930395, -1528703, -3677745, -3041255, -1452451,  3475950,  2176455, -1585221,
+    -1257611,  1939314, -4083598, -1000202, -3190144, -3157330, -3632928,   126922,
+    3412210, -983419,  2147896,  2715295, -2967645, -3693493, -411027, -2477047,
+    -671102, -1228525, -22981, -1308169, -381987,  1349076,  1852771, -1430430,
+    -3343383,   264944,   508951,  3097992,    44288, -1100098,   904516,  3958618,
+    -3724342, -8578,  1653064, -3249728,  2389356, -210977,   759969, -1316856,
+    189548, -3553272,  3159746, -1851402, -2409325, -177440,  1315589,  1341330,
+    1285669, -1584928, -812732, -1439742, -3019102, -3881060, -3628969,  3839961,
+    2091667,  3407706,  2316500,  3817976, -3342478,  2244091, -2446433, -3562462,
+    266997,  2434439, -1235728,  3513181, -3520352, -3759364, -1197226, -3193378,
+    900702,  1859098,   909542,   819034,   495491, -1613174, -43260, -522500,
+    -655327, -3122442,  2031748,  3207046, -3556995, -525098, -768622, -3595838,
+    342297,   286988, -2437823,  4108315,  3437287, -3342277,  1735879,   203044,
+    2842341,  2691481, -2590150,  1265009,  4055324,  1247620,  2486353,  1595974,
+    -3767016,  1250494,  2635921, -3548272, -2994039,  1869119,  1903435, -1050970,
+    -1333058,  1237275, -3318210, -1430225, -451100,  1312455,  3306115, -1962642,
+    -1279661,  1917081, -2546312, -1374803,  1500165,   777191,  2235880,  3406031,
+    -542412, -2831860, -1671176, -1846953, -2584293, -3724270,   594136, -3776993,
+    -2013608,  2432395,  2454455, -164721,  1957272,  3369112,   185531, -1207385,
+    -3183426,   162844,  1616392,  3014001,   810149,  1652634, -3694233, -1799107,
+    -3038916,  3523897,  3866901,   269760,  2213111, -975884,  1717735,   472078,
+    -426683,  1723600, -1803090,  1910376, -1667432, -1104333, -260646, -3833893,
+    -2939036, -2235985, -420899, -2286327,   183443, -976891,  1612842, -3545687,
+    -554416,  3919660, -48306, -1362209,  3937738,  1400424, -846154,  1976782
+};
+
+#if PQC_NTT_OPT
+
+/* zetas[i] * QINV mod 2^32 */
+static const int32_t zetas_qinv[N] = {
+    0, 1830765815, -1929875198, -1927777021, 1640767044, 1477910808, 1612161320, 1640734244,
+    308362795, -1815525077, -1374673747, -1091570561, -1929495947, 515185417, -285697463, 625853735,
+    1727305304, 2082316400, -1364982364, 858240904, 1806278032, 222489248, -346752664, 684667771,
+    1654287830, -878576921, -1257667337, -748618600, 329347125, 1837364258, -1443016191, -1170414139,
+    -1846138265, -1631226336, -1404529459, 1838055109, 1594295555, -1076973524, -1898723372, -594436433,
+    -202001019, -475984260, -561427818, 1797021249, -1061813248, 2059733581, -1661512036, -1104976547,
+    -1750224323, -901666090, 418987550, 1831915353, -1925356481, 992097815, 879957084, 2024403852,
+    1484874664, -1636082790, -285388938, -1983539117, -1495136972, -950076368, -1714807468, -952438995,
+    -1574918427, -654783359, 1350681039, -1974159335, -2143979939, 1651689966, 1599739335, 140455867,
+    -1285853323, -1039411342, -993005454, 1955560694, -1440787840, 1529189038, 568627424, -2131021878,
+    -783134478, -247357819, -588790216, 1518161567, 289871779, -86965173, -1262003603, 1708872713,
+    2135294594, 1787797779, -1018755525, 1638590967, -889861155, -120646188, 1665705315, -1669960606,
+    1321868265, -916321552, 1225434135, 1155548552, -1784632064, 2143745726, 666258756, 1210558298,
+    675310538, -1261461890, -1555941048, -318346816, -1999506068, 628664287, -1499481951, -1729304568,
+    -695180180, 1422575624, -1375177022, 1424130038, 1777179795, -1185330464, 334803717, 235321234,
+    -178766299, 168022240, -518252220, 1206536194, 1957047970, 985155484, 1146323031, -894060583,
+    -898413, 991903578, 1363007700, 746144248, -1363460238, 912367099, 30313375, -1420958686,
+    -605900043, -44694137, -326425360, 2032221021, 2027833504, 1176904444, 1683520342, 1904936414,
+    14253662, -421552614, -517299994, 1257750362, 1014493059, -818371958, 2027935492, 1926727420,
+    863641633, 1747917558, -1372618620, 1931587462, 1819892093, -325927722, 128353682, 1258381762,
+    2124962073, 908452108, -1123881663, 885133339, -1223601433, 1851023419, 137583815, 1629985060,
+    -1920467227, -1176751719, -635454918, 1967222129, -1637785316, -1354528380, -642772911, 6363718,
+    -1536588520, -72690498, 45766801, -1287922800, 694382729, -314284737, 671509323, 1136965286,
+    235104446, 985022747, -2070602178, 1779436847, -1045062172, 963438279, 419615363, 1116720494,
+    831969619, -1078959975, 1216882040, 1042326957, -300448763, 604552167, -270590488, 1405999311,
+    756955444, -1021949428, -1276805128, 713994583, -260312805, 608791570, 371462360, 940195359,
+    1554794072, 173440395, -1357098057, -1542497137, 1339088280, -2126092136, -384158533, 2061661095,
+    -2040058690, -1316619236, 827959816, -883155599, -853476187, -1039370342, -596344473, 1726753853,
+    -2047270596, 6087993, 702390549, -1547952704, -1723816713, -110126092, -279505433, 394851342,
+    -1591599803, 565464272, -260424530, 283780712, -440824168, -1758099917, -71875110, 776003547,
+    1119856484, -1600929361, -1208667171, 1123958025, 1544891539, 879867909, -1499603926, 201262505,
+    155290192, -1809756372, 2036925262, 1934038751, -973777462, 400711272, -540420426, 374860238
+};
+
+/*************************************************
+* Name:        fqmul
+*
+* Description: Montgomery multiplication by a twisted constant. For
+*              zeta_qinv = zeta*QINV mod 2^32 the result equals
+*              montgomery_reduce((int64_t)zeta * a) exactly, since the two
+*              64-bit products subtracted there agree in their low words.
+*
+* Arguments:   - int32_t a: first factor
+*              - int32_t zeta: second factor
+*              - int32_t zeta_qinv: zeta*QINV mod 2^32
+*
+* Returns r with -Q < r < Q and r = a*zeta*2^{-32} mod Q.
+**************************************************/
+static inline int32_t fqmul(int32_t a, int32_t zeta, int32_t zeta_qinv) {
+    int32_t t;
+
+    t = (int32_t)((uint32_t)a * (uint32_t)zeta_qinv);
+    return (int32_t)(((int64_t)a * zeta) >> 32) - (int32_t)(((int64_t)t * Q) >> 32);
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLDSA_CLEAN_ntt
+*
+* Description: Forward NTT, in-place. No modular reduction is performed after
+*              additions or subtractions. Output vector is in bitreversed order.
+*
+* Arguments:   - uint32_t p[N]: input/output coefficient array
+**************************************************/
+NTT_IRAM void PQCLEAN_MLDSA_CLEAN_ntt(int32_t a[N]) {
+    unsigned int len, start, j, k;
+    int32_t z1, z1q, z2, z2q, z3, z3q;
+    int32_t a0, a1, a2, a3, t;
+
+    /* Layers len and len/2 together on a[j], a[j+len/2], a[j+len],
+     * a[j+3len/2]; blocks of 2*len use zeta index N/(2*len) + block */
+    for (len = 128; len > 1; len >>= 2) {
+        k = N / (2 * len);
+        for (start = 0; start < N; start += 2 * len, ++k) {
+            z1 = zetas[k];
+            z1q = zetas_qinv[k];
+            z2 = zetas[2 * k];
+            z2q = zetas_qinv[2 * k];
+            z3 = zetas[2 * k + 1];
+            z3q = zetas_qinv[2 * k + 1];
+            for (j = start; j < start + len / 2; ++j) {
+                a0 = a[j];
+                a1 = a[j + len / 2];
+                a2 = a[j + len];
+                a3 = a[j + 3 * len / 2];
+
+                t = fqmul(a2, z1, z1q);
+                a2 = a0 - t;
+                a0 = a0 + t;
+                t = fqmul(a3, z1, z1q);
+                a3 = a1 - t;
+                a1 = a1 + t;
+
+                t = fqmul(a1, z2, z2q);
+                a1 = a0 - t;
+                a0 = a0 + t;
+                t = fqmul(a3, z3, z3q);
+                a3 = a2 - t;
+                a2 = a2 + t;
+
+                a[j] = a0;
+                a[j + len / 2] = a1;
+                a[j + len] = a2;
+                a[j + 3 * len / 2] = a3;
+            }
+        }
+    }
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLDSA_CLEAN_invntt_tomont
+*
+* Description: Inverse NTT and multiplication by Montgomery factor 2^32.
+*              In-place. No modular reductions after additions or
+*              subtractions; input coefficients need to be smaller than
+*              Q in absolute value. Output coefficient are smaller than Q in
+*              absolute value.
+*
+* Arguments:   - uint32_t p[N]: input/output coefficient array
+**************************************************/
+NTT_IRAM void PQCLEAN_MLDSA_CLEAN_invntt_tomont(int32_t a[N]) {
+    unsigned int start, len, j, k;
+    int32_t z1, z1q, z2, z2q, z3, z3q;
+    int32_t a0, a1, a2, a3, t;
+    const int32_t f = 41978; // mont^2/256
+    const int32_t fq = -8395782; // f*QINV mod 2^32
+
+    /* Layers len and 2*len together on a[j], a[j+len], a[j+2len], a[j+3len];
+     * the blocks of layer len use zeta index N/len - 1 - block, negated */
+    for (len = 1; len < N; len <<= 2) {
+        k = N / len - 1;
+        for (start = 0; start < N; start += 4 * len, k -= 2) {
+            z1 = -zetas[k];
+            z1q = -zetas_qinv[k];
+            z2 = -zetas[k - 1];
+            z2q = -zetas_qinv[k - 1];
+            z3 = -zetas[(k - 1) / 2];
+            z3q = -zetas_qinv[(k - 1) / 2];
+            for (j = start; j < start + len; ++j) {
+                a0 = a[j];
+                a1 = a[j + len];
+                a2 = a[j + 2 * len];
+                a3 = a[j + 3 * len];
+
+                t = a0;
+                a0 = t + a1;
+                a1 = fqmul(t - a1, z1, z1q);
+                t = a2;
+                a2 = t + a3;
+                a3 = fqmul(t - a3, z2, z2q);
+
+                t = a0;
+                a0 = t + a2;
+                a2 = fqmul(t - a2, z3, z3q);
+                t = a1;
+                a1 = t + a3;
+                a3 = fqmul(t - a3, z3, z3q);
+
+                if (len == N / 4) {
+                    a0 = fqmul(a0, f, fq);
+                    a1 = fqmul(a1, f, fq);
+                    a2 = fqmul(a2, f, fq);
+                    a3 = fqmul(a3, f, fq);
+                }
+
+                a[j] = a0;
+                a[j + len] = a1;
+                a[j + 2 * len] = a2;
+                a[j + 3 * len] = a3;
+            }
+        }
+    }
+}
+
+#else
+/*************************************************
+* Name:        PQCLEAN_MLDSA_CLEAN_ntt
+*
+* Description: Forward NTT, in-place. No modular reduction is performed after
+*              additions or subtractions. Output vector is in bitreversed order.
+*
+* Arguments:   - uint32_t p[N]: input/output coefficient array
+**************************************************/
+void PQCLEAN_MLDSA_CLEAN_ntt(int32_t a[N]) {
+    unsigned int len, start, j, k;
+    int32_t zeta, t;
+
+    k = 0;
+    for (len = 128; len > 0; len >>= 1) {
+        for (start = 0; start < N; start = j + len) {
+            zeta = zetas[++k];
+            for (j = start; j < start + len; ++j) {
+                t = PQCLEAN_MLDSA_CLEAN_montgomery_reduce((int64_t)zeta * a[j + len]);
+                a[j + len] = a[j] - t;
+                a[j] = a[j] + t;
+            }
+        }
+    }
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLDSA_CLEAN_invntt_tomont
+*
+* Description: Inverse NTT and multiplication by Montgomery factor 2^32.
+*              In-place. No modular reductions after additions or
+*              subtractions; input coefficients need to be smaller than
+*              Q in absolute value. Output coefficient are smaller than Q in
+*              absolute value.
+*
+* Arguments:   - uint32_t p[N]: input/output coefficient array
+**************************************************/
+void PQCLEAN_MLDSA_CLEAN_invntt_tomont(int32_t a[N]) {
+    unsigned int start, len, j, k;
+    int32_t t, zeta;
+    const int32_t f = 41978; // mont^2/256
+
+    k = 256;
+    for (len = 1; len < N; len <<= 1) {
+        for (start = 0; start < N; start = j + len) {
+            zeta = -zetas[--k];
+            for (j = start; j < start + len; ++j) {
+                t = a[j];
+                a[j] = t + a[j + len];
+                a[j + len] = t - a[j + len];
+                a[j + len] = PQCLEAN_MLDSA_CLEAN_montgomery_reduce((int64_t)zeta * a[j + len]);
+            }
+        }
+    }
+
+    for (j = 0; j < N; ++j) {
+        a[j] = PQCLEAN_MLDSA_CLEAN_montgomery_reduce((int64_t)f * a[j]);
+    }
+}
+
+#endif
+
+static uint32_t ntt_kat_digest(const int32_t a[N]) {
+    unsigned int i;
+    uint32_t h = 2166136261UL;
+
+    for (i = 0; i < N; ++i) {
+        h = (h ^ (uint32_t)PQCLEAN_MLDSA_CLEAN_freeze(a[i])) * 16777619UL;
+    }
+    return h;
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLDSA_CLEAN_ntt_kat
+*
+* Description: Known-answer self-test of the NTT backend. Checks the forward
+*              and inverse transform of a fixed pseudorandom vector against
+*              digests of the reference output (taken modulo Q, so a backend
+*              is free to pick other representatives within the documented
+*              bounds), and that the inverse undoes the forward transform.
+*
+* Returns 0 on success, -1 on mismatch.
+**************************************************/
+int PQCLEAN_MLDSA_CLEAN_ntt_kat(void) {
+    const uint32_t fwd_exp = 0x0dca44a0UL;
+    const uint32_t inv_exp = 0xf5747fd9UL;
+    int32_t a[N], b[N], c[N];
+    unsigned int i;
+    uint32_t x = 1;
+
+    for (i = 0; i < N; ++i) {
+        x = x * 1103515245UL + 12345UL;
+        a[i] = (int32_t)((x >> 8) % (2 * Q - 1)) - (Q - 1);
+        b[i] = a[i];
+        c[i] = a[i];
+    }
+
+    PQCLEAN_MLDSA_CLEAN_ntt(b);
+    PQCLEAN_MLDSA_CLEAN_invntt_tomont(c);
+    if (ntt_kat_digest(b) != fwd_exp || ntt_kat_digest(c) != inv_exp) {
+        return -1;
+    }
+
+    PQCLEAN_MLDSA_CLEAN_invntt_tomont(b);
+    for (i = 0; i < N; ++i) {
+        if (b[i] <= -Q || b[i] >= Q
+            || PQCLEAN_MLDSA_CLEAN_freeze(b[i])
+            != PQCLEAN_MLDSA_CLEAN_freeze((int32_t)(((int64_t)a[i] * MONT) % Q))) {
+            return -1;
+        }
+    }
+    return 0;
+}
@@ -3,7 +3,7 @@
 #include <stdint.h>
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_montgomery_reduce
+* Name:        PQCLEAN_MLDSA_CLEAN_montgomery_reduce
 *
 * Description: For finite field element a with -2^{31}Q <= a <= Q*2^31,
 *              compute r \equiv a*2^{-32} (mod Q) such that -Q < r < Q.
@@ -12,7 +12,7 @@
 *
 * Returns r.
 **************************************************/
-int32_t PQCLEAN_MLDSA44_CLEAN_montgomery_reduce(int64_t a) {
+int32_t PQCLEAN_MLDSA_CLEAN_montgomery_reduce(int64_t a) {
     int32_t t;
 
     t = (int32_t)((uint64_t)a * (uint64_t)QINV);
@@ -21,7 +21,7 @@ int32_t PQCLEAN_MLDSA44_CLEAN_montgomery_reduce(int64_t a) {
 }
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_reduce32
+* Name:        PQCLEAN_MLDSA_CLEAN_reduce32
 *
 * Description: For finite field element a with a <= 2^{31} - 2^{22} - 1,
 *              compute r \equiv a (mod Q) such that -6283008 <= r <= 6283008.
@@ -30,7 +30,7 @@ int32_t PQCLEAN_MLDSA44_CLEAN_montgomery_reduce(int64_t a) {
 *
 * Returns r.
 **************************************************/
-int32_t PQCLEAN_MLDSA44_CLEAN_reduce32(int32_t a) {
+int32_t PQCLEAN_MLDSA_CLEAN_reduce32(int32_t a) {
     int32_t t;
 
     t = (a + (1 << 22)) >> 23;
@@ -39,7 +39,7 @@ int32_t PQCLEAN_MLDSA44_CLEAN_reduce32(int32_t a) {
 }
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_caddq
+* Name:        PQCLEAN_MLDSA_CLEAN_caddq
 *
 * Description: Add Q if input coefficient is negative.
 *
@@ -47,13 +47,13 @@ int32_t PQCLEAN_MLDSA44_CLEAN_reduce32(int32_t a) {
 *
 * Returns r.
 **************************************************/
-int32_t PQCLEAN_MLDSA44_CLEAN_caddq(int32_t a) {
+int32_t PQCLEAN_MLDSA_CLEAN_caddq(int32_t a) {
     a += (a >> 31) & Q;
     return a;
 }
 
 /*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_freeze
+* Name:        PQCLEAN_MLDSA_CLEAN_freeze
 *
 * Description: For finite field element a, compute standard
 *              representative r = a mod^+ Q.
@@ -62,8 +62,8 @@ int32_t PQCLEAN_MLDSA44_CLEAN_caddq(int32_t a) {
 *
 * Returns r.
 **************************************************/
-int32_t PQCLEAN_MLDSA44_CLEAN_freeze(int32_t a) {
-    a = PQCLEAN_MLDSA44_CLEAN_reduce32(a);
-    a = PQCLEAN_MLDSA44_CLEAN_caddq(a);
+int32_t PQCLEAN_MLDSA_CLEAN_freeze(int32_t a) {
+    a = PQCLEAN_MLDSA_CLEAN_reduce32(a);
+    a = PQCLEAN_MLDSA_CLEAN_caddq(a);
     return a;
 }
@@ -0,0 +1,58 @@
+#include "fips202.h"
+#include "params.h"
+#include "symmetric.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+void PQCLEAN_MLDSA_CLEAN_dilithium_shake128_stream_init(shake128incctx *state, const uint8_t seed[SEEDBYTES], uint16_t nonce) {
+    uint8_t t[2];
+    t[0] = (uint8_t) nonce;
+    t[1] = (uint8_t) (nonce >> 8);
+
+    shake128_inc_init(state);
+    shake128_inc_absorb(state, seed, SEEDBYTES);
+    shake128_inc_absorb(state, t, 2);
+    shake128_inc_finalize(state);
+}
+
+void PQCLEAN_MLDSA_CLEAN_dilithium_shake256_stream_init(shake256incctx *state, const uint8_t seed[CRHBYTES], uint16_t nonce) {
+    uint8_t t[2];
+    t[0] = (uint8_t) nonce;
+    t[1] = (uint8_t) (nonce >> 8);
+
+    shake256_inc_init(state);
+    shake256_inc_absorb(state, seed, CRHBYTES);
+    shake256_inc_absorb(state, t, 2);
+    shake256_inc_finalize(state);
+}
+
+void PQCLEAN_MLDSA_CLEAN_dilithium_shake128x4_stream_init(keccakx4_state *state, const uint8_t seed[SEEDBYTES], const uint16_t nonce[4], unsigned int mask) {
+    uint8_t t[4][SEEDBYTES + 2];
+    const uint8_t *in[4];
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        memcpy(t[j], seed, SEEDBYTES);
+        t[j][SEEDBYTES + 0] = (uint8_t) nonce[j];
+        t[j][SEEDBYTES + 1] = (uint8_t) (nonce[j] >> 8);
+        in[j] = (mask & (1u << j)) ? t[j] : NULL;
+    }
+
+    shake128x4_absorb_once(state, in[0], in[1], in[2], in[3], SEEDBYTES + 2);
+}
+
+void PQCLEAN_MLDSA_CLEAN_dilithium_shake256x4_stream_init(keccakx4_state *state, const uint8_t seed[CRHBYTES], const uint16_t nonce[4], unsigned int mask) {
+    uint8_t t[4][CRHBYTES + 2];
+    const uint8_t *in[4];
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        memcpy(t[j], seed, CRHBYTES);
+        t[j][CRHBYTES + 0] = (uint8_t) nonce[j];
+        t[j][CRHBYTES + 1] = (uint8_t) (nonce[j] >> 8);
+        in[j] = (mask & (1u << j)) ? t[j] : NULL;
+    }
+
+    shake256x4_absorb_once(state, in[0], in[1], in[2], in[3], CRHBYTES + 2);
+}
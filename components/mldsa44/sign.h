@@ -1,31 +0,0 @@
-#ifndef PQCLEAN_MLDSA44_CLEAN_SIGN_H
-#define PQCLEAN_MLDSA44_CLEAN_SIGN_H
-#include "params.h"
-#include "poly.h"
-#include "polyvec.h"
-#include <stddef.h>
-#include <stdint.h>
-
-int PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair(uint8_t *pk, uint8_t *sk);
-
-int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx(uint8_t *sig, size_t *siglen,
-        const uint8_t *m, size_t mlen,
-        const uint8_t *ctx, size_t ctxlen,
-        const uint8_t *sk);
-
-int PQCLEAN_MLDSA44_CLEAN_crypto_sign_ctx(uint8_t *sm, size_t *smlen,
-        const uint8_t *m, size_t mlen,
-        const uint8_t *ctx, size_t ctxlen,
-        const uint8_t *sk);
-
-int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx(const uint8_t *sig, size_t siglen,
-        const uint8_t *m, size_t mlen,
-        const uint8_t *ctx, size_t ctxlen,
-        const uint8_t *pk);
-
-int PQCLEAN_MLDSA44_CLEAN_crypto_sign_open_ctx(uint8_t *m, size_t *mlen,
-        const uint8_t *sm, size_t smlen,
-        const uint8_t *ctx, size_t ctxlen,
-        const uint8_t *pk);
-
-#endif
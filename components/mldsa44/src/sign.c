@@ -1,509 +0,0 @@
-#include "fips202.h"
-#include "packing.h"
-#include "params.h"
-#include <stdio.h>
-#include "poly.h"
-#include "polyvec.h"
-#include "randombytes.h"
-#include "sign.h"
-#include "symmetric.h"
-#include <stdint.h>
-#include <stdlib.h>    // For malloc, free
-
-
-/*************************************************
-* Name:        PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair
-*
-* Description: Generates public and private key.
-*
-* Arguments:   - uint8_t *pk: pointer to output public key (allocated
-*                             array of PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES bytes)
-*              - uint8_t *sk: pointer to output private key (allocated
-*                             array of PQCLEAN_MLDSA44_CLEAN_CRYPTO_SECRETKEYBYTES bytes)
-*
-* Returns 0 (success)
-**************************************************/
-int PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair(uint8_t *pk, uint8_t *sk) {
-    uint8_t *seedbuf = malloc(2 * SEEDBYTES + CRHBYTES);
-    uint8_t *tr = malloc(TRBYTES);
-    if (seedbuf == NULL || tr == NULL) {
-        free(seedbuf);
-        free(tr);
-        return -1;
-    }
-
-    const uint8_t *rho, *rhoprime, *key;
-    polyvecl *mat = malloc(sizeof(polyvecl) * K);
-    polyvecl *s1 = malloc(sizeof(polyvecl));
-    polyvecl *s1hat = malloc(sizeof(polyvecl));
-    polyveck *s2 = malloc(sizeof(polyveck));
-    polyveck *t1 = malloc(sizeof(polyveck));
-    polyveck *t0 = malloc(sizeof(polyveck));
-    if (mat == NULL || s1 == NULL || s1hat == NULL || s2 == NULL || t1 == NULL || t0 == NULL) {
-        free(seedbuf);
-        free(tr);
-        free(mat);
-        free(s1);
-        free(s1hat);
-        free(s2);
-        free(t1);
-        free(t0);
-        return -1;
-    }
-
-    /* Get randomness for rho, rhoprime and key */
-    randombytes(seedbuf, SEEDBYTES);
-    seedbuf[SEEDBYTES + 0] = K;
-    seedbuf[SEEDBYTES + 1] = L;
-    shake256(seedbuf, 2 * SEEDBYTES + CRHBYTES, seedbuf, SEEDBYTES + 2);
-    rho = seedbuf;
-    rhoprime = rho + SEEDBYTES;
-    key = rhoprime + CRHBYTES;
-
-    /* Expand matrix */
-    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_expand(mat, rho);
-
-    /* Sample short vectors s1 and s2 */
-    PQCLEAN_MLDSA44_CLEAN_polyvecl_uniform_eta(s1, rhoprime, 0);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_uniform_eta(s2, rhoprime, L);
-
-    /* Matrix-vector multiplication */
-    *s1hat = *s1;
-    PQCLEAN_MLDSA44_CLEAN_polyvecl_ntt(s1hat);
-    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_pointwise_montgomery(t1, mat, s1hat);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_reduce(t1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_invntt_tomont(t1);
-
-    /* Add error vector s2 */
-    PQCLEAN_MLDSA44_CLEAN_polyveck_add(t1, t1, s2);
-
-    /* Extract t1 and write public key */
-    PQCLEAN_MLDSA44_CLEAN_polyveck_caddq(t1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_power2round(t1, t0, t1);
-    PQCLEAN_MLDSA44_CLEAN_pack_pk(pk, rho, t1);
-
-    /* Compute H(rho, t1) and write secret key */
-    shake256(tr, TRBYTES, pk, PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES);
-    PQCLEAN_MLDSA44_CLEAN_pack_sk(sk, rho, tr, key, t0, s1, s2);
-
-    free(seedbuf);
-    free(tr);
-    free(mat);
-    free(s1);
-    free(s1hat);
-    free(s2);
-    free(t1);
-    free(t0);
-
-    return 0;
-}
-
-
-/*************************************************
-* Name:        crypto_sign_signature
-*
-* Description: Computes signature.
-*
-* Arguments:   - uint8_t *sig:   pointer to output signature (of length PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES)
-*              - size_t *siglen: pointer to output length of signature
-*              - uint8_t *m:     pointer to message to be signed
-*              - size_t mlen:    length of message
-*              - uint8_t *ctx:   pointer to context string
-*              - size_t ctxlen:  length of context string
-*              - uint8_t *sk:    pointer to bit-packed secret key
-*
-* Returns 0 (success) or -1 (context string too long)
-**************************************************/
-int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx(uint8_t *sig,
-        size_t *siglen,
-        const uint8_t *m,
-        size_t mlen,
-        const uint8_t *ctx,
-        size_t ctxlen,
-        const uint8_t *sk) {
-    if (ctxlen > 255) {
-        return -1;
-    }
-
-    // Allocate large structures on the heap
-    uint8_t *seedbuf = malloc(2 * SEEDBYTES + TRBYTES + RNDBYTES + 2 * CRHBYTES);
-    if (!seedbuf) {
-        printf("Failed to allocate memory for seedbuf\n");
-        return -1;
-    }
-
-    polyvecl *mat = malloc(sizeof(polyvecl) * K);
-    polyvecl *s1 = malloc(sizeof(polyvecl));
-    polyvecl *y = malloc(sizeof(polyvecl));
-    polyvecl *z = malloc(sizeof(polyvecl));
-    polyveck *t0 = malloc(sizeof(polyveck));
-    polyveck *s2 = malloc(sizeof(polyveck));
-    polyveck *w1 = malloc(sizeof(polyveck));
-    polyveck *w0 = malloc(sizeof(polyveck));
-    polyveck *h = malloc(sizeof(polyveck));
-    poly *cp = malloc(sizeof(poly));
-    if (!mat || !s1 || !y || !z || !t0 || !s2 || !w1 || !w0 || !h || !cp) {
-        printf("Failed to allocate memory for large structures\n");
-        free(seedbuf);
-        free(mat);
-        free(s1);
-        free(y);
-        free(z);
-        free(t0);
-        free(s2);
-        free(w1);
-        free(w0);
-        free(h);
-        free(cp);
-        return -1;
-    }
-
-    unsigned int n;
-    uint8_t *rho = seedbuf;
-    uint8_t *tr = rho + SEEDBYTES;
-    uint8_t *key = tr + TRBYTES;
-    uint8_t *rnd = key + SEEDBYTES;
-    uint8_t *mu = rnd + RNDBYTES;
-    uint8_t *rhoprime = mu + CRHBYTES;
-    uint16_t nonce = 0; 
-    shake256incctx state;
-
-    PQCLEAN_MLDSA44_CLEAN_unpack_sk(rho, tr, key, t0, s1, s2, sk);
-
-    /* Compute mu = CRH(tr, 0, ctxlen, ctx, msg) */
-    mu[0] = 0;
-    mu[1] = (uint8_t)ctxlen;
-    shake256_inc_init(&state);
-    shake256_inc_absorb(&state, tr, TRBYTES);
-    shake256_inc_absorb(&state, mu, 2);
-    shake256_inc_absorb(&state, ctx, ctxlen);
-    shake256_inc_absorb(&state, m, mlen);
-    shake256_inc_finalize(&state);
-    shake256_inc_squeeze(mu, CRHBYTES, &state);
-    shake256_inc_ctx_release(&state);
-
-    randombytes(rnd, RNDBYTES);
-    shake256(rhoprime, CRHBYTES, key, SEEDBYTES + RNDBYTES + CRHBYTES);
-
-    /* Expand matrix and transform vectors */
-    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_expand(mat, rho);
-    PQCLEAN_MLDSA44_CLEAN_polyvecl_ntt(s1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_ntt(s2);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_ntt(t0);
-
-rej:
-    /* Sample intermediate vector y */
-    PQCLEAN_MLDSA44_CLEAN_polyvecl_uniform_gamma1(y, rhoprime, nonce++);
-
-    /* Matrix-vector multiplication */
-    *z = *y;
-    PQCLEAN_MLDSA44_CLEAN_polyvecl_ntt(z);
-    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_pointwise_montgomery(w1, mat, z);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_reduce(w1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_invntt_tomont(w1);
-
-    /* Decompose w and call the random oracle */
-    PQCLEAN_MLDSA44_CLEAN_polyveck_caddq(w1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_decompose(w1, w0, w1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_pack_w1(sig, w1);
-
-    shake256_inc_init(&state);
-    shake256_inc_absorb(&state, mu, CRHBYTES);
-    shake256_inc_absorb(&state, sig, K * POLYW1_PACKEDBYTES);
-    shake256_inc_finalize(&state);
-    shake256_inc_squeeze(sig, CTILDEBYTES, &state);
-    shake256_inc_ctx_release(&state);
-    PQCLEAN_MLDSA44_CLEAN_poly_challenge(cp, sig);
-    PQCLEAN_MLDSA44_CLEAN_poly_ntt(cp);
-
-    /* Compute z, reject if it reveals secret */
-    PQCLEAN_MLDSA44_CLEAN_polyvecl_pointwise_poly_montgomery(z, cp, s1);
-    PQCLEAN_MLDSA44_CLEAN_polyvecl_invntt_tomont(z);
-    PQCLEAN_MLDSA44_CLEAN_polyvecl_add(z, z, y);
-    PQCLEAN_MLDSA44_CLEAN_polyvecl_reduce(z);
-    if (PQCLEAN_MLDSA44_CLEAN_polyvecl_chknorm(z, GAMMA1 - BETA)) {
-        goto rej;
-    }
-
-    /* Check that subtracting cs2 does not change high bits of w and low bits
-     * do not reveal secret information */
-    PQCLEAN_MLDSA44_CLEAN_polyveck_pointwise_poly_montgomery(h, cp, s2);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_invntt_tomont(h);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_sub(w0, w0, h);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_reduce(w0);
-    if (PQCLEAN_MLDSA44_CLEAN_polyveck_chknorm(w0, GAMMA2 - BETA)) {
-        goto rej;
-    }
-
-    /* Compute hints for w1 */
-    PQCLEAN_MLDSA44_CLEAN_polyveck_pointwise_poly_montgomery(h, cp, t0);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_invntt_tomont(h);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_reduce(h);
-    if (PQCLEAN_MLDSA44_CLEAN_polyveck_chknorm(h, GAMMA2)) {
-        goto rej;
-    }
-
-    PQCLEAN_MLDSA44_CLEAN_polyveck_add(w0, w0, h);
-    n = PQCLEAN_MLDSA44_CLEAN_polyveck_make_hint(h, w0, w1);
-    if (n > OMEGA) {
-        goto rej;
-    }
-
-    /* Write signature */
-    PQCLEAN_MLDSA44_CLEAN_pack_sig(sig, sig, z, h);
-    *siglen = PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES;
-
-    free(seedbuf);
-    free(mat);
-    free(s1);
-    free(y);
-    free(z);
-    free(t0);
-    free(s2);
-    free(w1);
-    free(w0);
-    free(h);
-    free(cp);
-
-    return 0;
-}
-
-
-/*************************************************
-* Name:        crypto_sign
-*
-* Description: Compute signed message.
-*
-* Arguments:   - uint8_t *sm: pointer to output signed message (allocated
-*                             array with PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES + mlen bytes),
-*                             can be equal to m
-*              - size_t *smlen: pointer to output length of signed
-*                               message
-*              - const uint8_t *m: pointer to message to be signed
-*              - size_t mlen: length of message
-*              - const uint8_t *ctx: pointer to context string
-*              - size_t ctxlen: length of context string
-*              - const uint8_t *sk: pointer to bit-packed secret key
-*
-* Returns 0 (success) or -1 (context string too long)
-**************************************************/
-int PQCLEAN_MLDSA44_CLEAN_crypto_sign_ctx(uint8_t *sm,
-        size_t *smlen,
-        const uint8_t *m,
-        size_t mlen,
-        const uint8_t *ctx,
-        size_t ctxlen,
-        const uint8_t *sk) {
-    int ret;
-    size_t i;
-
-    for (i = 0; i < mlen; ++i) {
-        sm[PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES + mlen - 1 - i] = m[mlen - 1 - i];
-    }
-    ret = PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx(sm, smlen, sm + PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES, mlen, ctx, ctxlen, sk);
-    *smlen += mlen;
-    return ret;
-}
-
-/*************************************************
-* Name:        crypto_sign_verify
-*
-* Description: Verifies signature.
-*
-* Arguments:   - uint8_t *m: pointer to input signature
-*              - size_t siglen: length of signature
-*              - const uint8_t *m: pointer to message
-*              - size_t mlen: length of message
-*              - const uint8_t *ctx: pointer to context string
-*              - size_t ctxlen: length of context string
-*              - const uint8_t *pk: pointer to bit-packed public key
-*
-* Returns 0 if signature could be verified correctly and -1 otherwise
-**************************************************/
-int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx(const uint8_t *sig,
-        size_t siglen,
-        const uint8_t *m,
-        size_t mlen,
-        const uint8_t *ctx,
-        size_t ctxlen,
-        const uint8_t *pk) {
-    if (ctxlen > 255 || siglen != PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES) {
-        return -1;
-    }
-
-    uint8_t *buf = malloc(K * POLYW1_PACKEDBYTES);
-    uint8_t *rho = malloc(SEEDBYTES);
-    uint8_t *mu = malloc(CRHBYTES);
-    uint8_t *c = malloc(CTILDEBYTES);
-    uint8_t *c2 = malloc(CTILDEBYTES);
-    if (!buf || !rho || !mu || !c || !c2) {
-        printf("Failed to allocate memory for large buffers\n");
-        free(buf);
-        free(rho);
-        free(mu);
-        free(c);
-        free(c2);
-        return -1;
-    }
-
-    poly *cp = malloc(sizeof(poly));
-    polyvecl *mat = malloc(sizeof(polyvecl) * K);
-    polyvecl *z = malloc(sizeof(polyvecl));
-    polyveck *t1 = malloc(sizeof(polyveck));
-    polyveck *w1 = malloc(sizeof(polyveck));
-    polyveck *h = malloc(sizeof(polyveck));
-    if (!cp || !mat || !z || !t1 || !w1 || !h) {
-        printf("Failed to allocate memory for large structures\n");
-        free(buf);
-        free(rho);
-        free(mu);
-        free(c);
-        free(c2);
-        free(cp);
-        free(mat);
-        free(z);
-        free(t1);
-        free(w1);
-        free(h);
-        return -1;
-    }
-
-    unsigned int i;
-    shake256incctx state;
-
-    PQCLEAN_MLDSA44_CLEAN_unpack_pk(rho, t1, pk);
-    if (PQCLEAN_MLDSA44_CLEAN_unpack_sig(c, z, h, sig)) {
-        goto cleanup;
-    }
-    if (PQCLEAN_MLDSA44_CLEAN_polyvecl_chknorm(z, GAMMA1 - BETA)) {
-        goto cleanup;
-    }
-
-    /* Compute CRH(H(rho, t1), msg) */
-    shake256(mu, TRBYTES, pk, PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES);
-    shake256_inc_init(&state);
-    shake256_inc_absorb(&state, mu, TRBYTES);
-    mu[0] = 0;
-    mu[1] = (uint8_t)ctxlen;
-    shake256_inc_absorb(&state, mu, 2);
-    shake256_inc_absorb(&state, ctx, ctxlen);
-    shake256_inc_absorb(&state, m, mlen);
-    shake256_inc_finalize(&state);
-    shake256_inc_squeeze(mu, CRHBYTES, &state);
-    shake256_inc_ctx_release(&state);
-
-    /* Matrix-vector multiplication; compute Az - c2^dt1 */
-    PQCLEAN_MLDSA44_CLEAN_poly_challenge(cp, c);
-    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_expand(mat, rho);
-
-    PQCLEAN_MLDSA44_CLEAN_polyvecl_ntt(z);
-    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_pointwise_montgomery(w1, mat, z);
-
-    PQCLEAN_MLDSA44_CLEAN_poly_ntt(cp);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_shiftl(t1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_ntt(t1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_pointwise_poly_montgomery(t1, cp, t1);
-
-    PQCLEAN_MLDSA44_CLEAN_polyveck_sub(w1, w1, t1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_reduce(w1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_invntt_tomont(w1);
-
-    /* Reconstruct w1 */
-    PQCLEAN_MLDSA44_CLEAN_polyveck_caddq(w1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_use_hint(w1, w1, h);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_pack_w1(buf, w1);
-
-    /* Call random oracle and verify challenge */
-    shake256_inc_init(&state);
-    shake256_inc_absorb(&state, mu, CRHBYTES);
-    shake256_inc_absorb(&state, buf, K * POLYW1_PACKEDBYTES);
-    shake256_inc_finalize(&state);
-    shake256_inc_squeeze(c2, CTILDEBYTES, &state);
-    shake256_inc_ctx_release(&state);
-
-    for (i = 0; i < CTILDEBYTES; ++i) {
-        if (c[i] != c2[i]) {
-            goto cleanup;
-        }
-    }
-
-    free(buf);
-    free(rho);
-    free(mu);
-    free(c);
-    free(c2);
-    free(cp);
-    free(mat);
-    free(z);
-    free(t1);
-    free(w1);
-    free(h);
-
-    return 0;
-
-cleanup:
-    free(buf);
-    free(rho);
-    free(mu);
-    free(c);
-    free(c2);
-    free(cp);
-    free(mat);
-    free(z);
-    free(t1);
-    free(w1);
-    free(h);
-
-    return -1;
-}
-
-
-/*************************************************
-* Name:        crypto_sign_open
-*
-* Description: Verify signed message.
-*
-* Arguments:   - uint8_t *m: pointer to output message (allocated
-*                            array with smlen bytes), can be equal to sm
-*              - size_t *mlen: pointer to output length of message
-*              - const uint8_t *sm: pointer to signed message
-*              - size_t smlen: length of signed message
-*              - const uint8_t *ctx: pointer to context tring
-*              - size_t ctxlen: length of context string
-*              - const uint8_t *pk: pointer to bit-packed public key
-*
-* Returns 0 if signed message could be verified correctly and -1 otherwise
-**************************************************/
-int PQCLEAN_MLDSA44_CLEAN_crypto_sign_open_ctx(uint8_t *m,
-        size_t *mlen,
-        const uint8_t *sm,
-        size_t smlen,
-        const uint8_t *ctx,
-        size_t ctxlen,
-        const uint8_t *pk) {
-    size_t i;
-
-    if (smlen < PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES) {
-        goto badsig;
-    }
-
-    *mlen = smlen - PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES;
-    if (PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx(sm, PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES, sm + PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES, *mlen, ctx, ctxlen, pk)) {
-        goto badsig;
-    } else {
-        /* All good, copy msg, return 0 */
-        for (i = 0; i < *mlen; ++i) {
-            m[i] = sm[PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES + i];
-        }
-        return 0;
-    }
-
-badsig:
-    /* Signature verification failed */
-    *mlen = 0;
-    for (i = 0; i < smlen; ++i) {
-        m[i] = 0;
-    }
-
-    return -1;
-}
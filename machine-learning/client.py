@@ -2,7 +2,10 @@ import streamlit as st
 import socket
 import time
 import binascii
+import hashlib
 import os
+import struct
+import threading
 
 # --- PQC Imports ---
 try:
@@ -15,12 +18,13 @@ except ImportError:
 # Utility Functions
 # ======================================================
 
-def send_to_esp32(ip, port, data_to_send):
+def send_to_esp32(ip, port, data_to_send, quiet=False):
     """Send message to ESP32 and receive response."""
     try:
         with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as s:
             s.settimeout(15)
-            st.write(f"Connecting to {ip}:{port}...")
+            if not quiet:
+                st.write(f"Connecting to {ip}:{port}...")
             s.connect((ip, port))
 
             s.sendall(data_to_send)
@@ -32,7 +36,7 @@ def send_to_esp32(ip, port, data_to_send):
                 if not chunk:
                     break
                 response += chunk
-        return response.decode("utf-8", errors="ignore").strip()
+        return response
     except Exception as e:
         st.error(f"Connection error: {e}")
         return None
@@ -55,6 +59,112 @@ def parse_response(response_str):
         return None
 
 
+# Binary response frame (main/pqc_wire.h): u32 length, then version,
+# algorithm ID, flags, key ID length, sign time in us, signature length and
+# public key length, followed by the signature, key ID and public key.
+WIRE_HEADER = struct.Struct(">IBBBBIHH")
+WIRE_VERSION = 1
+WIRE_F_PUBLIC_KEY = 0x01
+WIRE_F_KEY_ID = 0x02
+# Request types, sent ahead of the request body
+REQ_SIGN = 0x01
+REQ_GET_KEY = 0x02
+REQ_SIGN_FRAMED = 0x03
+
+
+def decode_binary_response(response):
+    """Decode a binary response frame into the fields of the text format."""
+    if len(response) < WIRE_HEADER.size:
+        st.error("Truncated response header.")
+        return None
+    length, version, alg_id, flags, keyid_len, time_us, sig_len, pk_len = \
+        WIRE_HEADER.unpack_from(response)
+    if version != WIRE_VERSION:
+        st.error(f"Unsupported wire version {version}.")
+        return None
+    if len(response) < 4 + length or length != WIRE_HEADER.size - 4 + sig_len + keyid_len + pk_len:
+        st.error("Truncated or malformed response frame.")
+        return None
+    body = response[WIRE_HEADER.size:4 + length]
+    sig = body[:sig_len]
+    key_id = body[sig_len:sig_len + keyid_len] if flags & WIRE_F_KEY_ID else b""
+    pk = body[sig_len + keyid_len:] if flags & WIRE_F_PUBLIC_KEY else b""
+    return {
+        "ALG": f"ML-DSA-{alg_id}",
+        "TIME_MS": f"{time_us / 1000:.2f}",
+        "SIG": sig.hex(),
+        "PK": pk.hex(),
+        "KEY_ID": key_id.hex(),
+    }
+
+
+def decode_response(response):
+    """Decode either response format; the legacy text one starts with ALG:."""
+    if response.startswith(b"ALG:"):
+        return parse_response(response.decode("utf-8", errors="ignore").strip())
+    return decode_binary_response(response)
+
+
+def recv_exact(s, n):
+    """Read exactly n bytes from socket s."""
+    data = b""
+    while len(data) < n:
+        chunk = s.recv(n - len(data))
+        if not chunk:
+            raise ConnectionError("connection closed mid-frame")
+        data += chunk
+    return data
+
+
+def read_frame(s):
+    """Read one binary response frame, length prefix included."""
+    prefix = recv_exact(s, 4)
+    return prefix + recv_exact(s, struct.unpack(">I", prefix)[0])
+
+
+def sign_burst(ip, port, messages):
+    """Sign several messages over one persistent connection. All framed
+    requests are pipelined ahead of the responses, which come back in
+    request order."""
+    try:
+        with socket.create_connection((ip, port), timeout=15) as s:
+            requests = b"".join(bytes([REQ_SIGN_FRAMED]) + struct.pack(">I", len(m)) + m
+                                for m in messages)
+            # Send from another thread so a long burst cannot stall on
+            # responses nobody is reading yet
+            sender = threading.Thread(target=s.sendall, args=(requests,))
+            sender.start()
+            responses = [read_frame(s) for _ in messages]
+            sender.join()
+        return responses
+    except Exception as e:
+        st.error(f"Connection error: {e}")
+        return None
+
+
+def get_public_key(ip, port, key_id_hex):
+    """Public key for a key ID (its SHA3-256 fingerprint), fetched from the
+    ESP32 the first time and cached for the rest of the session."""
+    cache = st.session_state.setdefault("key_cache", {})
+    if key_id_hex in cache:
+        return cache[key_id_hex]
+
+    key_id = bytes.fromhex(key_id_hex)
+    resp = send_to_esp32(ip, port, bytes([REQ_GET_KEY]) + key_id, quiet=True)
+    if not resp:
+        return None
+    parsed = decode_binary_response(resp)
+    if not parsed or not parsed["PK"]:
+        st.error("ESP32 does not know this key ID.")
+        return None
+    pk = bytes.fromhex(parsed["PK"])
+    if hashlib.sha3_256(pk).digest() != key_id:
+        st.error("Fetched public key does not match its fingerprint.")
+        return None
+    cache[key_id_hex] = pk
+    return pk
+
+
 def verify_signature(pk_bytes, sig_bytes, msg_bytes, algo):
     """Verify signature based on detected algorithm."""
     try:
@@ -83,10 +193,12 @@ with st.sidebar:
     st.header("🔌 ESP32 Connection")
     esp_ip = st.text_input("ESP32 IP Address", "192.168.137.180")
     esp_port = st.number_input("ESP32 Port", 1, 65535, 8080)
+    legacy = st.checkbox("Legacy text protocol", False,
+                         help="For firmware built with PQC_WIRE_LEGACY_TEXT=1")
 
 # Message Input
 st.header("✉️ Message to Sign")
-tab1, tab2 = st.tabs(["Custom Text", "Random Bytes"])
+tab1, tab2, tab3 = st.tabs(["Custom Text", "Random Bytes", "Burst"])
 
 data_to_send = None
 
@@ -96,12 +208,30 @@ with tab1:
         data_to_send = msg.encode()
 
 with tab2:
-    data_len = st.slider("Random data size (bytes)", 16, 1024, 128, 16)
+    data_len = st.slider("Random data size (bytes)", 16, 65536, 128, 16)
     if st.button("Sign Random Data"):
         random_data = os.urandom(data_len)
         st.code(binascii.hexlify(random_data).decode(), language="text")
         data_to_send = random_data
 
+with tab3:
+    burst_count = st.slider("Messages per burst", 2, 64, 8)
+    burst_len = st.slider("Message size (bytes)", 16, 4096, 128, 16)
+    if st.button("Sign Burst", disabled=legacy):
+        burst = [os.urandom(burst_len) for _ in range(burst_count)]
+        start = time.time()
+        responses = sign_burst(esp_ip, esp_port, burst)
+        elapsed = time.time() - start
+        if responses:
+            valid = 0
+            for message, resp in zip(burst, responses):
+                parsed = decode_binary_response(resp)
+                pk = parsed and get_public_key(esp_ip, esp_port, parsed["KEY_ID"])
+                if pk and verify_signature(pk, bytes.fromhex(parsed["SIG"]), message, parsed["ALG"])[0]:
+                    valid += 1
+            st.metric("Signatures per second", f"{len(burst) / elapsed:.2f}")
+            st.write(f"{valid}/{len(burst)} signatures valid over one connection in {elapsed:.3f} sec")
+
 # ======================================================
 # Signing + Verification
 # ======================================================
@@ -112,25 +242,36 @@ if data_to_send:
 
     with st.spinner("Communicating with ESP32..."):
         start = time.time()
-        resp = send_to_esp32(esp_ip, esp_port, data_to_send)
+        request = data_to_send if legacy else bytes([REQ_SIGN]) + data_to_send
+        resp = send_to_esp32(esp_ip, esp_port, request)
         elapsed = time.time() - start
 
     if not resp:
         st.stop()
 
     st.metric("Total Round-Trip Time", f"{elapsed:.3f} sec")
+    st.write(f"Response Size: {len(resp)} bytes")
 
-    parsed = parse_response(resp)
+    parsed = decode_response(resp)
     if not parsed:
         st.stop()
 
     algo = parsed.get("ALG", "Unknown")
     sig_hex = parsed.get("SIG", "")
     pk_hex = parsed.get("PK", "")
+    key_id_hex = parsed.get("KEY_ID", "")
+
+    # Binary responses name the key by fingerprint instead of carrying it
+    if not pk_hex and key_id_hex:
+        cached = key_id_hex in st.session_state.get("key_cache", {})
+        pk = get_public_key(esp_ip, esp_port, key_id_hex)
+        if pk:
+            pk_hex = pk.hex()
+            st.write(f"Key ID: {key_id_hex[:16]}… ({'cached' if cached else 'fetched'})")
 
     if not sig_hex or not pk_hex:
         st.error("ESP32 did not return valid signature or public key.")
-        st.text_area("Raw Response", resp)
+        st.text_area("Raw Response", resp.hex())
         st.stop()
 
     sig_bytes = binascii.unhexlify(sig_hex)
@@ -138,6 +279,8 @@ if data_to_send:
 
     col1, col2 = st.columns(2)
     col1.metric("Algorithm Reported by ESP32", algo)
+    if "TIME_MS" in parsed:
+        st.write(f"Sign Time on ESP32: {parsed['TIME_MS']} ms")
     col2.metric("Public Key Length", f"{len(pk_bytes)} bytes")
 
     st.write(f"Signature Length: {len(sig_bytes)} bytes")
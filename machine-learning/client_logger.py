@@ -10,6 +10,10 @@ LOG_CSV = "dataset_raw.csv"
 SAMPLES = 10000
 SAMPLE_INTERVAL = 2.0  # seconds
 
+# Request type of a sign request whose message runs to the end of the
+# stream (PQC_REQ_SIGN in main/pqc_wire.h)
+REQ_SIGN = 0x01
+
 # message sizes to vary
 MSG_SIZES = [32, 64, 128, 256, 512, 1024]
 
@@ -54,7 +58,7 @@ def main():
                          "msg_size","sign_time_ms","label"])
         for i in range(SAMPLES):
             msg = generate_message(random.choice(MSG_SIZES))
-            payload = msg  # Optionally prefix algorithm request string
+            payload = bytes([REQ_SIGN]) + msg
             # send request and measure time
             try:
                 sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
@@ -62,7 +66,10 @@ def main():
                 t0 = time.time()
                 sock.connect((ESP_IP, ESP_PORT))
                 sock.sendall(payload)
-                sig = sock.recv(8192)
+                sock.shutdown(socket.SHUT_WR)  # end of message
+                # The server closes the connection after the response
+                while sock.recv(8192):
+                    pass
                 t1 = time.time()
                 sock.close()
                 sign_time_ms = (t1 - t0) * 1000.0
@@ -17,6 +17,10 @@ X_train, X_test, y_train, y_test = train_test_split(X_scaled, y, test_size=0.2)
 model = tf.keras.Sequential([
     tf.keras.layers.Input(shape=(X_train.shape[1],)),
     tf.keras.layers.Dense(8, activation='relu'),
+    # Dilithium2 (0) vs Dilithium5 (1), see preprocessing.py. With three
+    # labelled tiers this becomes Dense(3, activation='softmax') with
+    # sparse_categorical_crossentropy, and TFLiteRunner::predict takes the
+    # highest score instead of banding this one.
     tf.keras.layers.Dense(1, activation='sigmoid')
 ])
 
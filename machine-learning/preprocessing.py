@@ -7,6 +7,11 @@ dilithium2_p2 = pd.read_csv('dataset-suite\dilithium2-p2.csv')
 dilithium2 = pd.concat([dilithium2_p1, dilithium2_p2], ignore_index=True)
 dilithium5 = pd.read_csv('dataset-suite\dilithium5.csv')
 
+# Binary labels: there is no Dilithium3 dataset yet, so the model scores
+# Dilithium2 (0) against Dilithium5 (1) and the firmware carves the
+# Dilithium3 tier out of the middle of that score (kTierLow/kTierHigh in
+# main/tflite_runner.h). Once Dilithium3 runs are collected, label them 1,
+# Dilithium5 2, and train the softmax head noted in model-training.py.
 dilithium2['true_algo'] = 0
 dilithium5['true_algo'] = 1
 
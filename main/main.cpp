@@ -1,12 +1,14 @@
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
 #include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
-#include <string>
-#include <sstream>
-#include <iomanip>
+#include <initializer_list>
 
+#include "sdkconfig.h"
 #include "esp_system.h"
 #include "esp_wifi.h"
 #include "esp_event.h"
@@ -15,10 +17,12 @@
 #include "esp_netif.h"
 #include "esp_timer.h"
 #include "esp_mac.h"
+#include "esp_vfs_eventfd.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
+#include "freertos/queue.h"
 #include "freertos/event_groups.h"
 
 #include "lwip/sockets.h"
@@ -27,36 +31,401 @@
 // PQC includes
 extern "C" {
 #include "mldsa44/api.h"
+#include "mldsa65/api.h"
 #include "mldsa87/api.h"
+#include "fips202.h"
 }
 
 // TinyML model runner
 #include "tflite_runner.h"
 
+// Dual-core signing helper
+#include "pqc_parallel.h"
+
+// DRBG for the per-signature randomness
+#include "pqc_drbg.h"
+
+// Binary response framing
+#include "pqc_wire.h"
+
 #define PORT 8080
 #define TAG "PQC_SERVER"
 #define RECV_BUFFER_SIZE 1024
+// An unframed request body runs until the client shuts down its sending
+// side. A client that keeps it open is served after this long without data.
+#define PQC_RECV_IDLE_MS 2000
+// A persistent connection is closed after this long without a new request,
+// or without taking any of its response
+#define PQC_CONN_IDLE_MS 10000
+// Connections waiting to be accepted
+#define PQC_LISTEN_BACKLOG 4
+// Connections served at once by the event loop; further clients wait in
+// the listen backlog. CONFIG_LWIP_MAX_SOCKETS has to leave room for them.
+#define PQC_MAX_CONNS 24
+// Responses are built in PQC_RESP_BUFS buffers allocated at boot, enough
+// for every worker and two more responses on their way out. A hashed
+// request waits for a free one before it goes to a worker.
+#define PQC_RESP_BUFS (PQC_WORKERS + 2)
+// Longest a response may take to go out once signed. A client that has not
+// taken it by then is dropped and the buffer goes back to the pool, so
+// clients that stop reading pause signing for this long rather than for
+// PQC_CONN_IDLE_MS. That pause is what is left: PQC_RESP_BUFS of them at
+// once still stall every worker until the first one is dropped.
+#define PQC_WRITE_STALL_MS 2000
+// Hashed requests that step the model's tier down by one; see
+// pqc_backlog_tier
+#define PQC_QUEUE_STEP_DOWN 2
+// Longest the event loop sleeps, which bounds how late idle connections
+// are noticed
+#define PQC_LOOP_TICK_MS 500
+// Body length of a request that runs to the end of the stream
+#define PQC_BODY_TO_EOF SIZE_MAX
+// Requests open with a type byte and responses go out as a binary frame
+// (see pqc_wire.h). 1 switches back to the legacy text exchange: the bare
+// message in, "ALG:..|TIME_MS:..|SIG:<hex>|PK:<hex>" out, with the full
+// key in every response and twice the bytes on air. The message ends when
+// the client shuts down its sending side; one that does not waits
+// PQC_RECV_IDLE_MS for every response.
+#ifndef PQC_WIRE_LEGACY_TEXT
+#define PQC_WIRE_LEGACY_TEXT 0
+#endif
 
 // --- Dilithium2 (ML-DSA-44) ---
 #define D2_KEYPAIR  PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair
-#define D2_SIGN     PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature
+#define D2_EXPAND   PQCLEAN_MLDSA44_CLEAN_crypto_sign_expand_sk
+#define D2_EXPAND_COMPACT PQCLEAN_MLDSA44_CLEAN_crypto_sign_expand_sk_compact
+#define D2_SIGN     PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_esk
+#define D2_SIGN_INIT   PQCLEAN_MLDSA44_CLEAN_crypto_sign_init_ctx_esk
+#define D2_SIGN_UPDATE PQCLEAN_MLDSA44_CLEAN_crypto_sign_update
+#define D2_SIGN_FINAL  PQCLEAN_MLDSA44_CLEAN_crypto_sign_final_esk
+#define D2_SIGN_FINAL_PRE PQCLEAN_MLDSA44_CLEAN_crypto_sign_final_esk_pre
+#define D2_PRESIGN  PQCLEAN_MLDSA44_CLEAN_crypto_sign_presign
 #define D2_PUBBYTES PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES
 #define D2_SECBYTES PQCLEAN_MLDSA44_CLEAN_CRYPTO_SECRETKEYBYTES
 #define D2_SIGBYTES PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES
+#define D2_ESKBYTES PQCLEAN_MLDSA44_CLEAN_CRYPTO_EXPANDEDSKBYTES
+#define D2_ESK_COMPACTBYTES PQCLEAN_MLDSA44_CLEAN_CRYPTO_EXPANDEDSK_COMPACTBYTES
+#define D2_WSBYTES  PQCLEAN_MLDSA44_CLEAN_CRYPTO_ESK_WORKSPACEBYTES
+#define D2_PRESIGBYTES PQCLEAN_MLDSA44_CLEAN_CRYPTO_PRESIGBYTES
+#define D2_STATEBYTES PQCLEAN_MLDSA44_CLEAN_CRYPTO_SIGN_STATEBYTES
+#define D2_SET_PARALLEL PQCLEAN_MLDSA44_CLEAN_crypto_sign_set_parallel
+#define D2_SIGN_KAT PQCLEAN_MLDSA44_CLEAN_crypto_sign_kat
+#define D2_SET_RND  PQCLEAN_MLDSA44_CLEAN_crypto_sign_set_rnd
+#define D2_RND_DETERMINISTIC PQCLEAN_MLDSA44_CLEAN_crypto_sign_rnd_deterministic
+
+// --- Dilithium3 (ML-DSA-65) ---
+#define D3_KEYPAIR  PQCLEAN_MLDSA65_CLEAN_crypto_sign_keypair
+#define D3_EXPAND   PQCLEAN_MLDSA65_CLEAN_crypto_sign_expand_sk
+#define D3_EXPAND_COMPACT PQCLEAN_MLDSA65_CLEAN_crypto_sign_expand_sk_compact
+#define D3_SIGN     PQCLEAN_MLDSA65_CLEAN_crypto_sign_signature_esk
+#define D3_SIGN_INIT   PQCLEAN_MLDSA65_CLEAN_crypto_sign_init_ctx_esk
+#define D3_SIGN_UPDATE PQCLEAN_MLDSA65_CLEAN_crypto_sign_update
+#define D3_SIGN_FINAL  PQCLEAN_MLDSA65_CLEAN_crypto_sign_final_esk
+#define D3_SIGN_FINAL_SPEC PQCLEAN_MLDSA65_CLEAN_crypto_sign_final_esk_spec
+#define D3_SIGN_FINAL_PRE PQCLEAN_MLDSA65_CLEAN_crypto_sign_final_esk_pre
+#define D3_PRESIGN  PQCLEAN_MLDSA65_CLEAN_crypto_sign_presign
+#define D3_PUBBYTES PQCLEAN_MLDSA65_CLEAN_CRYPTO_PUBLICKEYBYTES
+#define D3_SECBYTES PQCLEAN_MLDSA65_CLEAN_CRYPTO_SECRETKEYBYTES
+#define D3_SIGBYTES PQCLEAN_MLDSA65_CLEAN_CRYPTO_BYTES
+#define D3_ESKBYTES PQCLEAN_MLDSA65_CLEAN_CRYPTO_EXPANDEDSKBYTES
+#define D3_ESK_COMPACTBYTES PQCLEAN_MLDSA65_CLEAN_CRYPTO_EXPANDEDSK_COMPACTBYTES
+#define D3_WSBYTES  PQCLEAN_MLDSA65_CLEAN_CRYPTO_ESK_WORKSPACEBYTES
+#define D3_PRESIGBYTES PQCLEAN_MLDSA65_CLEAN_CRYPTO_PRESIGBYTES
+#define D3_STATEBYTES PQCLEAN_MLDSA65_CLEAN_CRYPTO_SIGN_STATEBYTES
+#define D3_SET_PARALLEL PQCLEAN_MLDSA65_CLEAN_crypto_sign_set_parallel
+#define D3_SIGN_KAT PQCLEAN_MLDSA65_CLEAN_crypto_sign_kat
+#define D3_SET_RND  PQCLEAN_MLDSA65_CLEAN_crypto_sign_set_rnd
+#define D3_RND_DETERMINISTIC PQCLEAN_MLDSA65_CLEAN_crypto_sign_rnd_deterministic
 
 // --- Dilithium5 (ML-DSA-87) ---
 #define D5_KEYPAIR  PQCLEAN_MLDSA87_CLEAN_crypto_sign_keypair
-#define D5_SIGN     PQCLEAN_MLDSA87_CLEAN_crypto_sign_signature
+#define D5_EXPAND   PQCLEAN_MLDSA87_CLEAN_crypto_sign_expand_sk
+#define D5_EXPAND_COMPACT PQCLEAN_MLDSA87_CLEAN_crypto_sign_expand_sk_compact
+#define D5_SIGN     PQCLEAN_MLDSA87_CLEAN_crypto_sign_signature_esk
+#define D5_SIGN_INIT   PQCLEAN_MLDSA87_CLEAN_crypto_sign_init_ctx_esk
+#define D5_SIGN_UPDATE PQCLEAN_MLDSA87_CLEAN_crypto_sign_update
+#define D5_SIGN_FINAL  PQCLEAN_MLDSA87_CLEAN_crypto_sign_final_esk
+#define D5_SIGN_FINAL_SPEC PQCLEAN_MLDSA87_CLEAN_crypto_sign_final_esk_spec
+#define D5_SIGN_FINAL_PRE PQCLEAN_MLDSA87_CLEAN_crypto_sign_final_esk_pre
+#define D5_PRESIGN  PQCLEAN_MLDSA87_CLEAN_crypto_sign_presign
 #define D5_PUBBYTES PQCLEAN_MLDSA87_CLEAN_CRYPTO_PUBLICKEYBYTES
 #define D5_SECBYTES PQCLEAN_MLDSA87_CLEAN_CRYPTO_SECRETKEYBYTES
 #define D5_SIGBYTES PQCLEAN_MLDSA87_CLEAN_CRYPTO_BYTES
+#define D5_ESKBYTES PQCLEAN_MLDSA87_CLEAN_CRYPTO_EXPANDEDSKBYTES
+#define D5_ESK_COMPACTBYTES PQCLEAN_MLDSA87_CLEAN_CRYPTO_EXPANDEDSK_COMPACTBYTES
+#define D5_WSBYTES  PQCLEAN_MLDSA87_CLEAN_CRYPTO_ESK_WORKSPACEBYTES
+#define D5_SPEC_WSBYTES PQCLEAN_MLDSA87_CLEAN_CRYPTO_ESK_SPEC_WORKSPACEBYTES
+#define D5_PRESIGBYTES PQCLEAN_MLDSA87_CLEAN_CRYPTO_PRESIGBYTES
+#define D5_STATEBYTES PQCLEAN_MLDSA87_CLEAN_CRYPTO_SIGN_STATEBYTES
+#define D5_SET_PARALLEL PQCLEAN_MLDSA87_CLEAN_crypto_sign_set_parallel
+#define D5_SIGN_KAT PQCLEAN_MLDSA87_CLEAN_crypto_sign_kat
+#define D5_SET_RND  PQCLEAN_MLDSA87_CLEAN_crypto_sign_set_rnd
+#define D5_RND_DETERMINISTIC PQCLEAN_MLDSA87_CLEAN_crypto_sign_rnd_deterministic
+
+// All levels run on the same NTT
+#define PQC_NTT_KAT PQCLEAN_MLDSA_CLEAN_ntt_kat
+
+#define PQC_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define PQC_WSBYTES PQC_MAX(D5_WSBYTES, PQC_MAX(D3_WSBYTES, D2_WSBYTES))
+// Room for two Dilithium5 attempts side by side (speculative mode)
+#define PQC_SPEC_WSBYTES PQC_MAX(D5_SPEC_WSBYTES, PQC_WSBYTES)
+// Message hash state, so the body never has to be held in memory
+#define PQC_STATEBYTES PQC_MAX(D5_STATEBYTES, PQC_MAX(D3_STATEBYTES, D2_STATEBYTES))
+
+// Below PQC_LOWMEM_ENTER_KB of free heap the expanded keys switch to their
+// compact form, without the matrix A and with 8/16-bit secrets (low-memory
+// mode). They grow back once the heap could absorb that and still stay
+// clear of the entry threshold.
+#define PQC_LOWMEM_ENTER_KB 48
+#define PQC_LOWMEM_EXIT_KB  (PQC_LOWMEM_ENTER_KB + 16 \
+        + (D2_ESKBYTES - D2_ESK_COMPACTBYTES + D3_ESKBYTES - D3_ESK_COMPACTBYTES \
+           + D5_ESKBYTES - D5_ESK_COMPACTBYTES) / 1024)
+
+// The event loop runs on one core and the signing helper on the other; the
+// workers alternate between the two.
+#define PQC_SERVER_CORE 0
+#define PQC_HELPER_CORE 1
+
+// Signing workers, each with its own workspace. The event loop hands them
+// requests whose message is hashed through a queue; its depth feeds the
+// backlog rule (pqc_backlog_tier). The loop itself runs the model and
+// re-expands keys, but does not sign.
+#ifndef PQC_WORKERS
+#define PQC_WORKERS 2
+#endif
+#define PQC_WORKER_PRIO    5
+// Above the workers, so the one sharing its core never delays an I/O event
+// by a scheduler tick; the loop blocks in select() whenever it is idle.
+#define PQC_LOOP_PRIO      (PQC_WORKER_PRIO + 1)
+#define PQC_WORKER_STACK   36864
+#define PQC_LOOP_STACK     16384
+
+// Pre-signing (opt-in): a low-priority task keeps up to PQC_PRESIGN_DEPTH
+// commitments (mask seed and w = A*y) per key ready while the server is
+// idle, so a request mostly just hashes mu and computes the response. Each
+// entry is used once; a rejected attempt moves on to the next one. 0 turns
+// it off.
+#ifndef PQC_PRESIGN_DEPTH
+#define PQC_PRESIGN_DEPTH 0
+#endif
+#define PQC_PRESIGN_PRIO  1
+// Its deepest path is crypto_sign_presign streaming a row of A through the
+// 4-way matrix sampler, the same as the helper's speculative attempt
+// (see PQC_HELPER_STACK in pqc_parallel.cpp), about 6 KB; the rest is
+// headroom. Each new low of the unused part is logged, with a warning under
+// PQC_PRESIGN_STACK_MARGIN.
+#define PQC_PRESIGN_STACK        8192
+#define PQC_PRESIGN_STACK_MARGIN 2048
+
+// The self-tests, keygen and the first key expansion run on the main task.
+// Their deepest path, a signing KAT or keygen down into a 4-way sampler,
+// takes about 8 KB; the rest is headroom. A boot leaving less than
+// PQC_BOOT_STACK_MARGIN unused is reported.
+#define PQC_BOOT_STACK        12288
+#define PQC_BOOT_STACK_MARGIN 2048
+static_assert(CONFIG_ESP_MAIN_TASK_STACK_SIZE >= PQC_BOOT_STACK,
+              "CONFIG_ESP_MAIN_TASK_STACK_SIZE too small for the boot self-tests and keygen");
+
+// Source of each signature's randomness rnd: the hardware RNG, a SHAKE256
+// DRBG seeded from it and reseeded periodically, or none (deterministic
+// signing of FIPS 204, reproducible signatures for regression runs; it
+// turns pre-signing off, whose entries would make them random again).
+#define PQC_RND_HW            0
+#define PQC_RND_DRBG          1
+#define PQC_RND_DETERMINISTIC 2
+#ifndef PQC_SIGN_RND
+#define PQC_SIGN_RND PQC_RND_HW
+#endif
+
+// Response buffer: a binary frame, or in the legacy exchange
+// "ALG:..|TIME_MS:..|SIG:" (at most PQC_LEGACY_PREFIX_MAX) and the hex
+// signature; "|PK:<hex>" goes out from pqc_legacy_pk.
+#if PQC_WIRE_LEGACY_TEXT
+#define PQC_LEGACY_PREFIX_MAX 64
+#define PQC_RESP_BYTES (PQC_LEGACY_PREFIX_MAX + 2 * D5_SIGBYTES)
+#else
+#define PQC_RESP_BYTES (PQC_WIRE_HDRBYTES + D5_SIGBYTES + PQC_WIRE_KEYIDBYTES)
+#endif
 
 // --- Global TinyML Runner ---
 TFLiteRunner ml_runner;
 
 // --- Global PQC keys ---
 static uint8_t pk2[D2_PUBBYTES], sk2[D2_SECBYTES];
+static uint8_t pk3[D3_PUBBYTES], sk3[D3_SECBYTES];
 static uint8_t pk5[D5_PUBBYTES], sk5[D5_SECBYTES];
+// SHA3-256 fingerprints of the public keys, sent as their key IDs
+static uint8_t kid2[PQC_WIRE_KEYIDBYTES], kid3[PQC_WIRE_KEYIDBYTES], kid5[PQC_WIRE_KEYIDBYTES];
+
+// --- Expanded secret keys and signing workspaces, allocated at boot ---
+// Allocated after keygen so its transient workspace does not add to this.
+// An expanded key holds the matrix A unless it is in compact form, where
+// signing regenerates A row by row and multiplies the small secrets by the
+// sparse challenge (more SHAKE128, much less memory).
+struct pqc_esk_t {
+    const uint8_t *sk;
+    size_t full_bytes;
+    size_t compact_bytes;
+    int (*expand)(void *esk, const uint8_t *sk);
+    int (*expand_compact)(void *esk, const uint8_t *sk);
+    uint8_t *buf;
+    bool compact;
+};
+static pqc_esk_t esk2 = {sk2, D2_ESKBYTES, D2_ESK_COMPACTBYTES, D2_EXPAND, D2_EXPAND_COMPACT, NULL, false};
+static pqc_esk_t esk3 = {sk3, D3_ESKBYTES, D3_ESK_COMPACTBYTES, D3_EXPAND, D3_EXPAND_COMPACT, NULL, false};
+static pqc_esk_t esk5 = {sk5, D5_ESKBYTES, D5_ESK_COMPACTBYTES, D5_EXPAND, D5_EXPAND_COMPACT, NULL, false};
+
+// Held while the model runs, while the keys change form, and while the
+// pre-signing pools or the signer count below change. Signing and
+// pre-signing run outside it, each in its own workspace; the event loop
+// takes it on every request, so nothing holds it across a signature.
+static SemaphoreHandle_t pqc_sign_lock;
+// Requests between key selection and the end of signing, plus an entry
+// being pre-signed; the keys only change form when there are none.
+static unsigned int pqc_active_signers = 0;
+// Duration of the last signature, an input of the model
+static float pqc_last_sign_ms = 0.0f;
+
+// Pre-signing pool of one key; entries [0, count) of capacity are ready.
+// A busy pool is being drawn from by a worker or topped up by the
+// pre-signing task and is left alone.
+struct pqc_presign_t {
+    pqc_esk_t *key;
+    size_t entry_bytes;
+    int (*presign)(void *pre, const void *esk, void *ws);
+    uint8_t *entries;
+    size_t capacity;
+    size_t count;
+    bool busy;
+};
+static pqc_presign_t pre2 = {&esk2, D2_PRESIGBYTES, D2_PRESIGN, NULL, 0, 0, false};
+static pqc_presign_t pre3 = {&esk3, D3_PRESIGBYTES, D3_PRESIGN, NULL, 0, 0, false};
+static pqc_presign_t pre5 = {&esk5, D5_PRESIGBYTES, D5_PRESIGN, NULL, 0, 0, false};
+static TaskHandle_t pqc_presign_handle;
+static uint8_t *pqc_presign_ws;
+
+// Requests hashed but not yet taken by a worker, and requests signed but
+// not yet picked up by the event loop. A worker writes to pqc_wake_fd
+// (an eventfd) after each one it finishes, to wake the loop's select().
+static QueueHandle_t pqc_job_queue;
+static QueueHandle_t pqc_done_queue;
+static int pqc_wake_fd = -1;
+
+// One signing worker
+struct pqc_worker_t {
+    uint8_t *ws;
+    bool spec_ready;  // workspace large enough for speculative signing
+};
+static pqc_worker_t pqc_workers[PQC_WORKERS];
+
+// Adaptive tiers, indexed by the class TFLiteRunner::predict returns. A
+// tier that spreads its signing across both cores does so when the helper
+// is up; Dilithium2 is short enough to leave the second core to the rest
+// of the system.
+struct pqc_tier_t {
+    const char *name;
+    int level;
+    uint8_t alg_id;
+    const uint8_t *pk;
+    size_t pk_bytes;
+    uint8_t *key_id;
+    pqc_esk_t *esk;
+    pqc_presign_t *pre;
+    bool spread;
+    int (*init)(void *st, const uint8_t *ctx, size_t ctxlen, const void *esk);
+    int (*update)(void *st, const uint8_t *m, size_t mlen);
+    int (*final)(uint8_t *sig, size_t *siglen, void *st, const void *esk, void *ws);
+    int (*final_spec)(uint8_t *sig, size_t *siglen, void *st, const void *esk, void *ws);
+    int (*final_pre)(uint8_t *sig, size_t *siglen, void *st, const void *esk,
+                     void *pre, size_t *npre, void *ws);
+    void (*set_parallel)(void (*par_for)(void (*body)(void *arg, unsigned int i),
+                                         void *arg, unsigned int n));
+};
+static const pqc_tier_t pqc_tiers[] = {
+    {"ML-DSA-44 (D2)", 2, 44, pk2, D2_PUBBYTES, kid2, &esk2, &pre2, false, D2_SIGN_INIT, D2_SIGN_UPDATE,
+     D2_SIGN_FINAL, NULL, D2_SIGN_FINAL_PRE, D2_SET_PARALLEL},
+    {"ML-DSA-65 (D3)", 3, 65, pk3, D3_PUBBYTES, kid3, &esk3, &pre3, true, D3_SIGN_INIT, D3_SIGN_UPDATE,
+     D3_SIGN_FINAL, D3_SIGN_FINAL_SPEC, D3_SIGN_FINAL_PRE, D3_SET_PARALLEL},
+    {"ML-DSA-87 (D5)", 5, 87, pk5, D5_PUBBYTES, kid5, &esk5, &pre5, true, D5_SIGN_INIT, D5_SIGN_UPDATE,
+     D5_SIGN_FINAL, D5_SIGN_FINAL_SPEC, D5_SIGN_FINAL_PRE, D5_SET_PARALLEL},
+};
+static_assert(sizeof(pqc_tiers) / sizeof(pqc_tiers[0]) == kPqcTiers,
+              "one tier per model class");
+
+// Signing memory that used to come out of the heap on every request
+static size_t pqc_reserved_bytes = 0;
+
+// Set once the helper task is up; dual-core signing is only offered then.
+static bool pqc_dual_core_ready = false;
+
+// How a request's signature is computed
+enum pqc_mode_t {
+    PQC_MODE_SINGLE,       // one core
+    PQC_MODE_DUAL_STAGES,  // each attempt split across both cores
+    PQC_MODE_SPECULATIVE,  // two attempts at once, one per core
+};
+
+// Where a connection is. The event loop moves it along; only SIGNING
+// belongs to a worker, which leaves it to the loop to send the response.
+// Nothing is read while a response is pending, so responses to pipelined
+// requests go out in order.
+enum pqc_conn_state_t {
+    PQC_CONN_FREE,
+    PQC_CONN_READ_TYPE,  // waiting for the next request's type byte, or
+                         // a legacy message's first bytes
+    PQC_CONN_READ_HEAD,  // a framed request's length, or a key ID
+    PQC_CONN_READ_BODY,  // hashing the message; holds a signer
+    PQC_CONN_READY,      // hashed, waiting for a response buffer
+    PQC_CONN_SIGNING,    // queued for or on a worker
+    PQC_CONN_WRITE,      // sending the response
+};
+
+// One client connection
+struct pqc_conn_t {
+    int sock;
+    pqc_conn_state_t state;
+    uint8_t req_type;
+    bool keep_open;       // read the next request once this one is answered
+    int64_t last_io_us;
+    unsigned served;      // requests whose response went out in full
+
+    uint8_t head[PQC_WIRE_KEYIDBYTES];
+    size_t head_len;
+    size_t head_have;
+
+    // Request being signed
+    const pqc_tier_t *tier;
+    uint64_t sign_state[(PQC_STATEBYTES + 7) / 8];
+    size_t body_len;
+    size_t body_have;
+    unsigned int queue_depth;
+    size_t free_heap;
+
+    // Response: up to two segments, from resp (one of the response
+    // buffers, owned from READY until the response is out) or from key_hdr
+    // and a public key
+    uint8_t *resp;
+    size_t resp_len;
+    int64_t resp_since_us; // when the worker finished it
+    uint8_t key_hdr[PQC_WIRE_HDRBYTES + PQC_WIRE_KEYIDBYTES];
+    const uint8_t *out[2];
+    size_t out_len[2];
+    int out_seg;
+    size_t out_pos;
+};
+static pqc_conn_t pqc_conns[PQC_MAX_CONNS];
+
+// Free response buffers, and READY connections in the order their
+// requests completed. Only the event loop touches either.
+static uint8_t *pqc_resp_free[PQC_RESP_BUFS];
+static int pqc_resp_nfree = 0;
+static pqc_conn_t *pqc_ready[PQC_MAX_CONNS];
+static unsigned int pqc_ready_head = 0, pqc_ready_count = 0;
+
+#if PQC_WIRE_LEGACY_TEXT
+// "|PK:<hex>" of each tier's key, the tail of every legacy response
+static uint8_t pqc_legacy_pk[kPqcTiers][4 + 2 * D5_PUBBYTES];
+#endif
 
 // --- Wi-Fi Event Group ---
 static EventGroupHandle_t s_wifi_event_group;
@@ -65,16 +434,152 @@ static EventGroupHandle_t s_wifi_event_group;
 static int s_retry_num = 0;
 
 /**
- * @brief Converts bytes to hex string.
+ * @brief Clears secret bytes before their memory goes back to the heap;
+ *        volatile so the stores are not dropped.
+ */
+static void pqc_wipe(void *p, size_t len) {
+    volatile uint8_t *b = (volatile uint8_t*)p;
+    for (size_t i = 0; i < len; i++) {
+        b[i] = 0;
+    }
+}
+
+/**
+ * @brief Puts an expanded key in full or compact form. Growing allocates
+ *        the new buffer before releasing the old one, so on failure the key
+ *        stays usable as it was; shrinking reuses the buffer, since the
+ *        expansion only reads the packed key. Whatever the old form leaves
+ *        behind is wiped before the heap gets it back.
+ */
+static bool pqc_esk_set_compact(pqc_esk_t *k, bool compact) {
+    if (k->buf && k->compact == compact) {
+        return true;
+    }
+
+    size_t old_bytes = k->buf ? (k->compact ? k->compact_bytes : k->full_bytes) : 0;
+    uint8_t *buf;
+    if (compact && k->buf) {
+        // realloc returns the tail unwiped
+        pqc_wipe(k->buf, old_bytes);
+        k->expand_compact(k->buf, k->sk);
+        buf = (uint8_t*)realloc(k->buf, k->compact_bytes);
+        if (!buf) {
+            buf = k->buf;
+        }
+    } else {
+        buf = (uint8_t*)malloc(compact ? k->compact_bytes : k->full_bytes);
+        if (!buf) {
+            return false;
+        }
+        (compact ? k->expand_compact : k->expand)(buf, k->sk);
+        if (k->buf) {
+            pqc_wipe(k->buf, old_bytes);
+        }
+        free(k->buf);
+    }
+
+    k->buf = buf;
+    k->compact = compact;
+    pqc_reserved_bytes = pqc_reserved_bytes - old_bytes
+                         + (compact ? k->compact_bytes : k->full_bytes);
+    return true;
+}
+
+/**
+ * @brief Tops up the pre-signing pools, one entry at a time, then sleeps
+ *        until a request has used some. The signing lock is only held to
+ *        claim a pool and to publish the entry: while the entry is
+ *        computed the pool is busy, so workers sign without it, and the
+ *        task counts as a signer, so the key keeps its form.
+ */
+static void pqc_presign_task(void *pvParams) {
+    UBaseType_t stack_low = PQC_PRESIGN_STACK;
+    while (1) {
+        pqc_presign_t *pool = NULL;
+        xSemaphoreTake(pqc_sign_lock, portMAX_DELAY);
+        for (pqc_presign_t *p : {&pre5, &pre3, &pre2}) {
+            if (!p->busy && p->count < p->capacity) {
+                pool = p;
+                pool->busy = true;
+                pqc_active_signers++;
+                break;
+            }
+        }
+        xSemaphoreGive(pqc_sign_lock);
+
+        if (pool) {
+            pool->presign(pool->entries + pool->count * pool->entry_bytes, pool->key->buf,
+                          pqc_presign_ws);
+            xSemaphoreTake(pqc_sign_lock, portMAX_DELAY);
+            pool->count++;
+            pool->busy = false;
+            pqc_active_signers--;
+            xSemaphoreGive(pqc_sign_lock);
+
+            UBaseType_t stack_left = uxTaskGetStackHighWaterMark(NULL);
+            if (stack_left < stack_low) {
+                stack_low = stack_left;
+                if (stack_left < PQC_PRESIGN_STACK_MARGIN) {
+                    ESP_LOGW(TAG, "Pre-signing stack nearly exhausted: %u bytes left.",
+                             (unsigned)stack_left);
+                } else {
+                    ESP_LOGI(TAG, "Pre-signing stack: %u bytes left.", (unsigned)stack_left);
+                }
+            }
+        } else {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+    }
+}
+
+/**
+ * @brief Allocates the pre-signing pools and their workspace and starts
+ *        the task that fills them on the helper core. Pre-signing stays
+ *        off if any of it fails.
+ */
+static void pqc_presign_init(void) {
+    pqc_presign_ws = (uint8_t*)malloc(PQC_WSBYTES);
+    bool ok = pqc_presign_ws != NULL;
+    for (pqc_presign_t *p : {&pre2, &pre3, &pre5}) {
+        p->entries = (uint8_t*)malloc(PQC_PRESIGN_DEPTH * p->entry_bytes);
+        ok = ok && p->entries;
+    }
+    if (ok && xTaskCreatePinnedToCore(pqc_presign_task, "pqc_presign", PQC_PRESIGN_STACK,
+                                      NULL, PQC_PRESIGN_PRIO, &pqc_presign_handle,
+                                      PQC_HELPER_CORE) == pdPASS) {
+        for (pqc_presign_t *p : {&pre2, &pre3, &pre5}) {
+            p->capacity = PQC_PRESIGN_DEPTH;
+            pqc_reserved_bytes += PQC_PRESIGN_DEPTH * p->entry_bytes;
+        }
+        pqc_reserved_bytes += PQC_WSBYTES;
+        ESP_LOGI(TAG, "Pre-signing %d entries per key.", PQC_PRESIGN_DEPTH);
+        return;
+    }
+
+    ESP_LOGW(TAG, "Not enough heap for pre-signing.");
+    for (pqc_presign_t *p : {&pre2, &pre3, &pre5}) {
+        free(p->entries);
+        p->entries = NULL;
+    }
+    free(pqc_presign_ws);
+    pqc_presign_ws = NULL;
+}
+
+#if PQC_WIRE_LEGACY_TEXT
+/**
+ * @brief Writes len bytes as 2*len lowercase hex digits. Each byte is read
+ *        before its digits are written, so bytes may sit in the same buffer
+ *        as out if it starts at least len bytes after it.
  */
-std::string bytes_to_hex_cpp(const uint8_t *bytes, size_t len) {
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
+static void pqc_hex(uint8_t *out, const uint8_t *bytes, size_t len) {
+    static const char digits[] = "0123456789abcdef";
     for (size_t i = 0; i < len; ++i) {
-        ss << std::setw(2) << static_cast<int>(bytes[i]);
+        uint8_t b = bytes[i];
+        out[2 * i] = digits[b >> 4];
+        out[2 * i + 1] = digits[b & 15];
     }
-    return ss.str();
 }
+#endif
 
 /**
  * @brief Wi-Fi event handler.
@@ -141,14 +646,518 @@ void wifi_init_dhcp(void) {
 }
 
 /**
- * @brief TCP server for PQC signing.
+ * @brief Hashed requests waiting for a response buffer or a worker.
  */
-void tcp_server_task(void *pvParams) {
-    char rx_buffer[RECV_BUFFER_SIZE];
+static unsigned int pqc_queue_depth(void) {
+    return pqc_ready_count + (pqc_job_queue ? (unsigned int)uxQueueMessagesWaiting(pqc_job_queue) : 0);
+}
+
+/**
+ * @brief Backlog rule applied after the model, which has no input for it
+ *        and was not trained on it: every PQC_QUEUE_STEP_DOWN requests
+ *        waiting to be signed step the model's tier down by one, so a
+ *        backlog drains on the faster levels.
+ */
+static int pqc_backlog_tier(int tier, unsigned int queue_depth) {
+    int step = (int)(queue_depth / PQC_QUEUE_STEP_DOWN);
+    if (step == 0 || tier == 0) {
+        return tier;
+    }
+    int stepped = step < tier ? tier - step : 0;
+    ESP_LOGI(TAG, "%u queued → Using %s instead of %s", queue_depth,
+             pqc_tiers[stepped].name, pqc_tiers[tier].name);
+    return stepped;
+}
+
+/**
+ * @brief Picks the level for a sign request and starts hashing its message,
+ *        before the body arrives. The connection holds a signer from here
+ *        until its worker is done.
+ */
+static void pqc_conn_start_sign(pqc_conn_t *c, size_t body_len) {
+    xSemaphoreTake(pqc_sign_lock, portMAX_DELAY);
+
+    // Trade SHAKE128 work for heap when memory runs low (see
+    // PQC_LOWMEM_ENTER_KB); growing back may fail and is retried later.
+    // Keys in use by another request keep their form until it is done.
+    if (pqc_active_signers == 0) {
+        size_t heap_kb = esp_get_free_heap_size() / 1024;
+        bool lowmem = esk5.compact || esk3.compact || esk2.compact;
+        if (heap_kb < PQC_LOWMEM_ENTER_KB) {
+            lowmem = true;
+        } else if (heap_kb > PQC_LOWMEM_EXIT_KB) {
+            lowmem = false;
+        }
+        pqc_esk_set_compact(&esk5, lowmem);
+        pqc_esk_set_compact(&esk3, lowmem);
+        pqc_esk_set_compact(&esk2, lowmem);
+    }
+
+    // Count the reserved signing memory as free so the model sees the
+    // scale it was trained on.
+    c->free_heap = (esp_get_free_heap_size() + pqc_reserved_bytes) / 1024;
+    c->queue_depth = pqc_queue_depth();
+    int tier = ml_runner.predict((float)c->free_heap, pqc_last_sign_ms, 0.0f);
+    c->tier = &pqc_tiers[pqc_backlog_tier(tier, c->queue_depth)];
+
+    c->tier->init(c->sign_state, NULL, 0, c->tier->esk->buf);
+    pqc_active_signers++;
+    xSemaphoreGive(pqc_sign_lock);
+
+    c->state = PQC_CONN_READ_BODY;
+    c->body_len = body_len;
+    c->body_have = 0;
+}
+
+/**
+ * @brief Lines up a fully hashed request for a response buffer and a
+ *        worker.
+ */
+static void pqc_conn_dispatch(pqc_conn_t *c) {
+    ESP_LOGI(TAG, "Received %u bytes", (unsigned)c->body_have);
+    c->state = PQC_CONN_READY;
+    pqc_ready[(pqc_ready_head + pqc_ready_count++) % PQC_MAX_CONNS] = c;
+}
+
+/**
+ * @brief Hands READY requests to the workers while response buffers last.
+ */
+static void pqc_dispatch_ready(void) {
+    while (pqc_ready_count > 0 && pqc_resp_nfree > 0) {
+        pqc_conn_t *c = pqc_ready[pqc_ready_head];
+        pqc_ready_head = (pqc_ready_head + 1) % PQC_MAX_CONNS;
+        pqc_ready_count--;
+
+        c->resp = pqc_resp_free[--pqc_resp_nfree];
+        c->state = PQC_CONN_SIGNING;
+        // One slot per connection, so this never waits
+        xQueueSend(pqc_job_queue, &c, portMAX_DELAY);
+    }
+}
+
+/**
+ * @brief Returns a connection's response buffer, if it has one.
+ */
+static void pqc_resp_release(pqc_conn_t *c) {
+    if (c->resp) {
+        pqc_resp_free[pqc_resp_nfree++] = c->resp;
+        c->resp = NULL;
+    }
+}
+
+/**
+ * @brief Frees a connection slot. A request still being read gives back
+ *        its signer.
+ */
+static void pqc_conn_close(pqc_conn_t *c) {
+    if (c->state == PQC_CONN_READ_BODY) {
+        xSemaphoreTake(pqc_sign_lock, portMAX_DELAY);
+        pqc_active_signers--;
+        xSemaphoreGive(pqc_sign_lock);
+    }
+#if !PQC_WIRE_LEGACY_TEXT
+    ESP_LOGI(TAG, "Served %u requests on this connection", c->served);
+#endif
+    pqc_resp_release(c);
+    shutdown(c->sock, 0);
+    close(c->sock);
+    c->state = PQC_CONN_FREE;
+}
+
+/**
+ * @brief Queues a response of up to two segments.
+ */
+static void pqc_conn_respond(pqc_conn_t *c, const uint8_t *a, size_t alen,
+                             const uint8_t *b, size_t blen) {
+    c->out[0] = a;
+    c->out_len[0] = alen;
+    c->out[1] = b;
+    c->out_len[1] = blen;
+    c->out_seg = 0;
+    c->out_pos = 0;
+    c->state = PQC_CONN_WRITE;
+}
+
+#if !PQC_WIRE_LEGACY_TEXT
+/**
+ * @brief Answers a key request: the public key whose fingerprint is in
+ *        c->head, or an empty frame if there is none.
+ */
+static void pqc_conn_key_response(pqc_conn_t *c) {
+    for (const pqc_tier_t &t : pqc_tiers) {
+        if (memcmp(t.key_id, c->head, PQC_WIRE_KEYIDBYTES) == 0) {
+            pqc_wire_header(c->key_hdr, t.alg_id, 0, 0, PQC_WIRE_KEYIDBYTES, t.pk_bytes);
+            memcpy(c->key_hdr + PQC_WIRE_HDRBYTES, t.key_id, PQC_WIRE_KEYIDBYTES);
+            pqc_conn_respond(c, c->key_hdr, sizeof(c->key_hdr), t.pk, t.pk_bytes);
+            ESP_LOGI(TAG, "Sent public key (D%d) len=%u bytes", t.level, (unsigned)t.pk_bytes);
+            return;
+        }
+    }
+    ESP_LOGW(TAG, "Key request for an unknown key");
+    pqc_wire_header(c->key_hdr, 0, 0, 0, 0, 0);
+    pqc_conn_respond(c, c->key_hdr, PQC_WIRE_HDRBYTES, NULL, 0);
+}
+#endif
+
+/**
+ * @brief Hashes a chunk of a request body and dispatches the request once
+ *        the body is complete. A body that runs to the end of the stream
+ *        is ended by pqc_conn_readable or pqc_conn_expire instead; a short
+ *        read says nothing, as a message longer than a segment arrives in
+ *        several.
+ */
+static void pqc_conn_hash_chunk(pqc_conn_t *c, const uint8_t *buf, size_t len) {
+    c->tier->update(c->sign_state, buf, len);
+    c->body_have += len;
+    if (c->body_have == c->body_len) {
+        pqc_conn_dispatch(c);
+    }
+}
+
+/**
+ * @brief Moves a connection along on incoming data (or the end of it).
+ *        One receive per call, so a busy peer cannot starve the others.
+ */
+static void pqc_conn_readable(pqc_conn_t *c) {
+    static char rx_buffer[RECV_BUFFER_SIZE];
+    int len;
+
+    switch (c->state) {
+#if PQC_WIRE_LEGACY_TEXT
+    case PQC_CONN_READ_TYPE:
+        // The bare message; the level is only picked once it starts
+        len = recv(c->sock, rx_buffer, sizeof(rx_buffer), 0);
+        if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (len <= 0) {
+            ESP_LOGW(TAG, "No data received or connection closed");
+            pqc_conn_close(c);
+            return;
+        }
+        pqc_conn_start_sign(c, PQC_BODY_TO_EOF);
+        pqc_conn_hash_chunk(c, (uint8_t*)rx_buffer, len);
+        break;
+#else
+    case PQC_CONN_READ_TYPE:
+        len = recv(c->sock, &c->req_type, 1, 0);
+        if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (len <= 0) {
+            if (c->served == 0) {
+                ESP_LOGW(TAG, "No data received or connection closed");
+            }
+            pqc_conn_close(c);
+            return;
+        }
+        c->head_have = 0;
+        switch (c->req_type) {
+        case PQC_REQ_SIGN:
+            c->keep_open = false;
+            pqc_conn_start_sign(c, PQC_BODY_TO_EOF);
+            break;
+        case PQC_REQ_SIGN_FRAMED:
+            c->keep_open = true;
+            c->head_len = 4;
+            c->state = PQC_CONN_READ_HEAD;
+            break;
+        case PQC_REQ_GET_KEY:
+            c->keep_open = true;
+            c->head_len = PQC_WIRE_KEYIDBYTES;
+            c->state = PQC_CONN_READ_HEAD;
+            break;
+        default:
+            ESP_LOGW(TAG, "Unknown request type %u", c->req_type);
+            pqc_conn_close(c);
+            return;
+        }
+        break;
+
+    case PQC_CONN_READ_HEAD:
+        len = recv(c->sock, c->head + c->head_have, c->head_len - c->head_have, 0);
+        if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (len <= 0) {
+            ESP_LOGW(TAG, "Incomplete request");
+            pqc_conn_close(c);
+            return;
+        }
+        c->head_have += len;
+        if (c->head_have < c->head_len) {
+            break;
+        }
+        if (c->req_type == PQC_REQ_GET_KEY) {
+            pqc_conn_key_response(c);
+        } else {
+            pqc_conn_start_sign(c, pqc_wire_load32(c->head));
+            if (c->body_len == 0) {
+                pqc_conn_dispatch(c);
+            }
+        }
+        break;
+#endif
+
+    case PQC_CONN_READ_BODY: {
+        // Hash the body chunk by chunk; memory use does not depend on its size.
+        size_t left = c->body_len - c->body_have;
+        len = recv(c->sock, rx_buffer, left < sizeof(rx_buffer) ? left : sizeof(rx_buffer), 0);
+        if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (len > 0) {
+            pqc_conn_hash_chunk(c, (uint8_t*)rx_buffer, len);
+        } else if (len == 0 && c->body_len == PQC_BODY_TO_EOF && c->body_have > 0) {
+            pqc_conn_dispatch(c);
+        } else if (c->body_len == PQC_BODY_TO_EOF) {
+            ESP_LOGW(TAG, "No data received or connection closed");
+            pqc_conn_close(c);
+            return;
+        } else {
+            ESP_LOGW(TAG, "Request cut short after %u of %u bytes",
+                     (unsigned)c->body_have, (unsigned)c->body_len);
+            pqc_conn_close(c);
+            return;
+        }
+        break;
+    }
+
+    default:
+        return;
+    }
+    c->last_io_us = esp_timer_get_time();
+}
+
+/**
+ * @brief Sends as much of the response as the socket takes; once it is
+ *        out, waits for the next request or closes.
+ */
+static void pqc_conn_writable(pqc_conn_t *c) {
+    while (c->out_seg < 2) {
+        size_t left = c->out_len[c->out_seg] - c->out_pos;
+        if (left == 0) {
+            c->out_seg++;
+            c->out_pos = 0;
+            continue;
+        }
+        int n = send(c->sock, c->out[c->out_seg] + c->out_pos, left, 0);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (n <= 0) {
+            pqc_conn_close(c);
+            return;
+        }
+        c->out_pos += n;
+        c->last_io_us = esp_timer_get_time();
+    }
+
+    pqc_resp_release(c);
+    c->served++;
+    if (!c->keep_open) {
+        pqc_conn_close(c);
+        return;
+    }
+    c->state = PQC_CONN_READ_TYPE;
+}
+
+/**
+ * @brief Closes connections that stopped making progress, or hold a
+ *        response buffer past PQC_WRITE_STALL_MS. A body that runs to the
+ *        end of the stream also ends when its client goes quiet, as long
+ *        as something arrived.
+ */
+static void pqc_conn_expire(pqc_conn_t *c, int64_t now_us) {
+    int64_t idle_ms = (now_us - c->last_io_us) / 1000;
+
+    switch (c->state) {
+    case PQC_CONN_WRITE:
+        // A key response holds no buffer and has the idle timeout only
+        if (c->resp && (now_us - c->resp_since_us) / 1000 > PQC_WRITE_STALL_MS) {
+            ESP_LOGW(TAG, "Response not taken within %d ms", PQC_WRITE_STALL_MS);
+            pqc_conn_close(c);
+            break;
+        }
+        // fall through
+    case PQC_CONN_READ_TYPE:
+        if (idle_ms > PQC_CONN_IDLE_MS) {
+            pqc_conn_close(c);
+        }
+        break;
+    case PQC_CONN_READ_HEAD:
+    case PQC_CONN_READ_BODY:
+        if (idle_ms <= PQC_RECV_IDLE_MS) {
+            break;
+        }
+        if (c->state == PQC_CONN_READ_BODY && c->body_len == PQC_BODY_TO_EOF && c->body_have > 0) {
+            pqc_conn_dispatch(c);
+        } else {
+            ESP_LOGW(TAG, "No data received or connection closed");
+            pqc_conn_close(c);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Takes a new connection into a free slot.
+ */
+static void pqc_conn_accept(int listen_sock) {
+    struct sockaddr_in source_addr;
+    socklen_t addr_len = sizeof(source_addr);
     char addr_str[128];
+
+    int sock = accept(listen_sock, (struct sockaddr *)&source_addr, &addr_len);
+    if (sock < 0) {
+        return;
+    }
+    inet_ntoa_r(source_addr.sin_addr.s_addr, addr_str, sizeof(addr_str) - 1);
+
+    pqc_conn_t *c = NULL;
+    for (pqc_conn_t &slot : pqc_conns) {
+        if (slot.state == PQC_CONN_FREE) {
+            c = &slot;
+            break;
+        }
+    }
+    if (!c) {
+        ESP_LOGW(TAG, "No free connection slot for %s", addr_str);
+        close(sock);
+        return;
+    }
+    ESP_LOGI(TAG, "Client connected: %s (queued: %u)", addr_str, pqc_queue_depth());
+
+    fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+    c->sock = sock;
+    c->served = 0;
+    c->last_io_us = esp_timer_get_time();
+    c->keep_open = false;
+    c->state = PQC_CONN_READ_TYPE;
+}
+
+/**
+ * @brief Finishes a request on a worker: signs under the key chosen at
+ *        its start and builds the response in the connection's response
+ *        buffer, so the worker is free again before the client has read
+ *        any of it.
+ */
+static void pqc_sign_job(pqc_conn_t *c, pqc_worker_t *worker) {
+    const pqc_tier_t *tier = c->tier;
+    // The signature goes straight behind the frame header, or at the end
+    // of a legacy buffer, from where it is hex-encoded in place
+#if PQC_WIRE_LEGACY_TEXT
+    uint8_t *sig = c->resp + PQC_RESP_BYTES - D5_SIGBYTES;
+#else
+    uint8_t *sig = c->resp + PQC_WIRE_HDRBYTES;
+#endif
+    size_t siglen = 0;
+    uint64_t start_time, end_time;
+    const char* algo_used = tier->name;
+
+    // Pre-signed attempts go first, from a pool no other worker is
+    // drawing from.
+    xSemaphoreTake(pqc_sign_lock, portMAX_DELAY);
+    pqc_presign_t *pool = NULL;
+    if (tier->pre->count > 0 && !tier->pre->busy) {
+        pool = tier->pre;
+        pool->busy = true;
+    }
+    xSemaphoreGive(pqc_sign_lock);
+    size_t pre_ready = pool ? pool->count : 0;
+
+    // Spread the higher tiers across both cores to cut their latency,
+    // preferring two attempts at once since rejection streaks dominate
+    // the tail. The helper falls back to this core while another worker
+    // has it.
+    pqc_mode_t mode = PQC_MODE_SINGLE;
+    if (tier->spread && pqc_dual_core_ready) {
+        mode = worker->spec_ready ? PQC_MODE_SPECULATIVE : PQC_MODE_DUAL_STAGES;
+    }
+
+    start_time = esp_timer_get_time();
+
+    if (pool) {
+        tier->final_pre(sig, &siglen, c->sign_state, tier->esk->buf,
+                        pool->entries, &pool->count, worker->ws);
+    } else if (mode == PQC_MODE_SPECULATIVE) {
+        tier->final_spec(sig, &siglen, c->sign_state, tier->esk->buf, worker->ws);
+    } else {
+        tier->final(sig, &siglen, c->sign_state, tier->esk->buf, worker->ws);
+    }
+
+    end_time = esp_timer_get_time();
+    float duration_ms = (end_time - start_time) / 1000.0f;
+
+    size_t pre_used = 0;
+    xSemaphoreTake(pqc_sign_lock, portMAX_DELAY);
+    if (pool) {
+        pre_used = pre_ready - pool->count;
+        pool->busy = false;
+    }
+    pqc_active_signers--;
+    pqc_last_sign_ms = duration_ms;
+    xSemaphoreGive(pqc_sign_lock);
+    if (pre_used > 0) {
+        xTaskNotifyGive(pqc_presign_handle);
+    }
+
+    ESP_LOGI(TAG, "🔒 Used Dilithium%d for signing", tier->level);
+
+    static const char *const mode_names[] = {"single", "dual", "speculative"};
+    ESP_LOGI(TAG, "SignTime: %.2f ms | FreeHeap: %.1f KB | Mode: %s | Key: %s | Pre: %u | Queue: %u",
+             duration_ms, (float)c->free_heap, mode_names[mode],
+             tier->esk->compact ? "compact" : "full",
+             (unsigned)pre_used, c->queue_depth);
+
+    // --- Build Response ---
+#if PQC_WIRE_LEGACY_TEXT
+    int prefix = snprintf((char*)c->resp, PQC_LEGACY_PREFIX_MAX + 1, "ALG:%s|TIME_MS:%.2f|SIG:",
+                          algo_used, duration_ms);
+    if (prefix > PQC_LEGACY_PREFIX_MAX) {
+        prefix = PQC_LEGACY_PREFIX_MAX;
+    }
+    // The prefix ends at least D5_SIGBYTES ahead of the signature
+    pqc_hex(c->resp + prefix, sig, siglen);
+    c->resp_len = prefix + 2 * siglen;
+    ESP_LOGI(TAG, "Sent public key (D%d) len=%u bytes", tier->level, (unsigned)tier->pk_bytes);
+#else
+    pqc_wire_header(c->resp, tier->alg_id, (uint32_t)(end_time - start_time),
+                    siglen, PQC_WIRE_KEYIDBYTES, 0);
+    memcpy(sig + siglen, tier->key_id, PQC_WIRE_KEYIDBYTES);
+    c->resp_len = PQC_WIRE_HDRBYTES + siglen + PQC_WIRE_KEYIDBYTES;
+#endif
+    ESP_LOGI(TAG, "✅ Response ready (%s)", algo_used);
+}
+
+/**
+ * @brief Signing worker: finishes the requests the event loop queues and
+ *        hands them back to it.
+ */
+static void pqc_worker_task(void *pvParams) {
+    pqc_worker_t *worker = (pqc_worker_t*)pvParams;
+    pqc_conn_t *c;
+    const uint64_t one = 1;
+
+    while (1) {
+        xQueueReceive(pqc_job_queue, &c, portMAX_DELAY);
+        pqc_sign_job(c, worker);
+        xQueueSend(pqc_done_queue, &c, portMAX_DELAY);
+        write(pqc_wake_fd, &one, sizeof(one));
+    }
+}
+
+/**
+ * @brief TCP server for PQC signing: one event loop over non-blocking
+ *        sockets. Reading requests, hashing their messages and writing
+ *        responses happen here; signing happens on the workers, so a slow
+ *        client holds neither a worker nor the other clients.
+ */
+void tcp_server_task(void *pvParams) {
     int addr_family = AF_INET;
     int ip_protocol = IPPROTO_IP;
-    float duration_ms = 0.0f;
 
     struct sockaddr_in dest_addr;
     dest_addr.sin_addr.s_addr = htonl(INADDR_ANY);
@@ -163,85 +1172,94 @@ void tcp_server_task(void *pvParams) {
     }
     ESP_LOGI(TAG, "Socket created, binding...");
     bind(listen_sock, (struct sockaddr *)&dest_addr, sizeof(dest_addr));
-    listen(listen_sock, 1);
+    listen(listen_sock, PQC_LISTEN_BACKLOG);
+    fcntl(listen_sock, F_SETFL, fcntl(listen_sock, F_GETFL, 0) | O_NONBLOCK);
+    ESP_LOGI(TAG, "Listening for clients...");
 
     while (1) {
-        ESP_LOGI(TAG, "Listening for client...");
-        struct sockaddr_in source_addr;
-        socklen_t addr_len = sizeof(source_addr);
-        int sock = accept(listen_sock, (struct sockaddr *)&source_addr, &addr_len);
-        if (sock < 0) {
-            ESP_LOGE(TAG, "Accept failed");
-            break;
-        }
-
-        inet_ntoa_r(source_addr.sin_addr.s_addr, addr_str, sizeof(addr_str) - 1);
-        ESP_LOGI(TAG, "Client connected: %s", addr_str);
+        fd_set rfds, wfds;
+        FD_ZERO(&rfds);
+        FD_ZERO(&wfds);
+        FD_SET(pqc_wake_fd, &rfds);
+        int max_fd = pqc_wake_fd;
+        bool slot_free = false;
 
-        int len = recv(sock, rx_buffer, sizeof(rx_buffer) - 1, 0);
-        if (len <= 0) {
-            ESP_LOGW(TAG, "No data received or connection closed");
-            close(sock);
-            continue;
+        for (pqc_conn_t &c : pqc_conns) {
+            switch (c.state) {
+            case PQC_CONN_FREE:
+                slot_free = true;
+                continue;
+            case PQC_CONN_READ_TYPE:
+            case PQC_CONN_READ_HEAD:
+            case PQC_CONN_READ_BODY:
+                FD_SET(c.sock, &rfds);
+                break;
+            case PQC_CONN_WRITE:
+                FD_SET(c.sock, &wfds);
+                break;
+            case PQC_CONN_READY:
+            case PQC_CONN_SIGNING:
+                continue;
+            }
+            if (c.sock > max_fd) {
+                max_fd = c.sock;
+            }
         }
 
-        rx_buffer[len] = 0;
-        ESP_LOGI(TAG, "Received %d bytes", len);
-
-        // --- ML-Adaptive PQC Logic ---
-        uint8_t sig[D5_SIGBYTES];
-        size_t siglen = 0;
-        uint64_t start_time, end_time;
-        const char* algo_used = nullptr;
-
-        size_t free_heap = esp_get_free_heap_size() / 1024;
-        int use_d5 = ml_runner.predict((float)free_heap, duration_ms, 0.0f);
-
-        start_time = esp_timer_get_time();
-
-        if (use_d5) {
-            D5_SIGN(sig, &siglen, (uint8_t*)rx_buffer, len, sk5);
-            algo_used = "ML-DSA-87 (D5)";
-            ESP_LOGI(TAG, "🔒 Used Dilithium5 for signing");
-        } else {
-            D2_SIGN(sig, &siglen, (uint8_t*)rx_buffer, len, sk2);
-            algo_used = "ML-DSA-44 (D2)";
-            ESP_LOGI(TAG, "🔒 Used Dilithium2 for signing");
+        // With every slot taken, new clients wait in the listen backlog
+        if (slot_free) {
+            FD_SET(listen_sock, &rfds);
+            if (listen_sock > max_fd) {
+                max_fd = listen_sock;
+            }
         }
 
-        end_time = esp_timer_get_time();
-        duration_ms = (end_time - start_time) / 1000.0f;
-
-        ESP_LOGI(TAG, "SignTime: %.2f ms | FreeHeap: %.1f KB", duration_ms, (float)free_heap);
-
-        // --- Send Response ---
-        std::stringstream ss_header;
-        ss_header << "ALG:" << algo_used
-                  << "|TIME_MS:" << std::fixed << std::setprecision(2) << duration_ms
-                  << "|SIG:";
-        std::string header_str = ss_header.str();
-        send(sock, header_str.c_str(), header_str.length(), 0);
-
-        std::string hex_sig = bytes_to_hex_cpp(sig, siglen);
-        send(sock, hex_sig.c_str(), hex_sig.length(), 0);
+        struct timeval tick = {PQC_LOOP_TICK_MS / 1000, (PQC_LOOP_TICK_MS % 1000) * 1000};
+        int ready = select(max_fd + 1, &rfds, &wfds, NULL, &tick);
+        if (ready < 0 && errno != EINTR) {
+            ESP_LOGE(TAG, "select failed: errno %d", errno);
+            break;
+        }
 
-        const char* pk_header = "|PK:";
-        send(sock, pk_header, strlen(pk_header), 0);
+        // Requests the workers finished go out next
+        if (ready > 0 && FD_ISSET(pqc_wake_fd, &rfds)) {
+            uint64_t count;
+            read(pqc_wake_fd, &count, sizeof(count));
+        }
+        pqc_conn_t *done;
+        while (xQueueReceive(pqc_done_queue, &done, 0) == pdTRUE) {
+            done->last_io_us = esp_timer_get_time();
+            done->resp_since_us = done->last_io_us;
+#if PQC_WIRE_LEGACY_TEXT
+            pqc_conn_respond(done, done->resp, done->resp_len, pqc_legacy_pk[done->tier - pqc_tiers],
+                             4 + 2 * done->tier->pk_bytes);
+#else
+            pqc_conn_respond(done, done->resp, done->resp_len, NULL, 0);
+#endif
+        }
 
-        std::string hex_pk;
-        if (use_d5) {
-            hex_pk = bytes_to_hex_cpp(pk5, D5_PUBBYTES);
-            ESP_LOGI(TAG, "Sent public key (D5) len=%d bytes", D5_PUBBYTES);
-        } else {
-            hex_pk = bytes_to_hex_cpp(pk2, D2_PUBBYTES);
-            ESP_LOGI(TAG, "Sent public key (D2) len=%d bytes", D2_PUBBYTES);
+        int64_t now_us = esp_timer_get_time();
+        for (pqc_conn_t &c : pqc_conns) {
+            if (ready > 0 && c.state == PQC_CONN_WRITE && FD_ISSET(c.sock, &wfds)) {
+                pqc_conn_writable(&c);
+                // A client taking its response a few bytes at a time keeps
+                // it writable; the write deadline applies all the same
+                if (c.state == PQC_CONN_WRITE) {
+                    pqc_conn_expire(&c, now_us);
+                }
+            } else if (ready > 0 && c.state >= PQC_CONN_READ_TYPE && c.state <= PQC_CONN_READ_BODY
+                       && FD_ISSET(c.sock, &rfds)) {
+                pqc_conn_readable(&c);
+            } else if (c.state != PQC_CONN_FREE) {
+                pqc_conn_expire(&c, now_us);
+            }
         }
-        send(sock, hex_pk.c_str(), hex_pk.length(), 0);
 
-        ESP_LOGI(TAG, "✅ Response sent successfully (%s)", algo_used);
+        pqc_dispatch_ready();
 
-        shutdown(sock, 0);
-        close(sock);
+        if (ready > 0 && FD_ISSET(listen_sock, &rfds)) {
+            pqc_conn_accept(listen_sock);
+        }
     }
 
     close(listen_sock);
@@ -272,12 +1290,134 @@ extern "C" void app_main(void) {
         ESP_LOGI(TAG, "Wi-Fi connected.");
         ml_runner.init();
 
+        if (fips202_kat() != 0) {
+            ESP_LOGE(TAG, "Keccak self-test failed.");
+            return;
+        }
+        if (PQC_NTT_KAT() != 0) {
+            ESP_LOGE(TAG, "NTT self-test failed.");
+            return;
+        }
+        if (D2_SIGN_KAT() != 0 || D3_SIGN_KAT() != 0 || D5_SIGN_KAT() != 0 || pqc_drbg_kat() != 0) {
+            ESP_LOGE(TAG, "Signing self-test failed.");
+            return;
+        }
+
+#if PQC_SIGN_RND == PQC_RND_DRBG
+        pqc_drbg_init();
+        D2_SET_RND(pqc_drbg_fill);
+        D3_SET_RND(pqc_drbg_fill);
+        D5_SET_RND(pqc_drbg_fill);
+        ESP_LOGI(TAG, "Signing randomness from the DRBG.");
+#elif PQC_SIGN_RND == PQC_RND_DETERMINISTIC
+        D2_SET_RND(D2_RND_DETERMINISTIC);
+        D3_SET_RND(D3_RND_DETERMINISTIC);
+        D5_SET_RND(D5_RND_DETERMINISTIC);
+        ESP_LOGI(TAG, "Deterministic signing.");
+#endif
+
         ESP_LOGI(TAG, "Generating keypairs...");
         D2_KEYPAIR(pk2, sk2);
+        D3_KEYPAIR(pk3, sk3);
         D5_KEYPAIR(pk5, sk5);
+        for (const pqc_tier_t &t : pqc_tiers) {
+            sha3_256(t.key_id, t.pk, t.pk_bytes);
+        }
+#if PQC_WIRE_LEGACY_TEXT
+        for (int i = 0; i < kPqcTiers; i++) {
+            memcpy(pqc_legacy_pk[i], "|PK:", 4);
+            pqc_hex(pqc_legacy_pk[i] + 4, pqc_tiers[i].pk, pqc_tiers[i].pk_bytes);
+        }
+#endif
+
+        // Start in low-memory mode if the full keys do not fit
+        for (pqc_esk_t *k : {&esk2, &esk3, &esk5}) {
+            if (!pqc_esk_set_compact(k, false)) {
+                ESP_LOGW(TAG, "Not enough heap for the full key, using the compact one.");
+                pqc_esk_set_compact(k, true);
+            }
+        }
+        // Speculative signing needs a second attempt's worth of workspace
+        // and the helper core, which one worker at a time can use; the
+        // first worker gets that room if the heap can spare it. Workers
+        // whose workspace does not fit are left out.
+        int workers = 0;
+        for (int i = 0; i < PQC_WORKERS; i++) {
+            pqc_worker_t *w = &pqc_workers[workers];
+            if (i == 0) {
+                w->ws = (uint8_t*)malloc(PQC_SPEC_WSBYTES);
+                if (w->ws) {
+                    w->spec_ready = true;
+                    pqc_reserved_bytes += PQC_SPEC_WSBYTES;
+                } else {
+                    ESP_LOGW(TAG, "Not enough heap for speculative signing.");
+                }
+            }
+            if (!w->ws) {
+                w->ws = (uint8_t*)malloc(PQC_WSBYTES);
+                if (!w->ws) {
+                    ESP_LOGW(TAG, "Not enough heap for more than %d signing workers.", workers);
+                    break;
+                }
+                pqc_reserved_bytes += PQC_WSBYTES;
+            }
+            workers++;
+        }
+        for (uint8_t *&buf : pqc_resp_free) {
+            buf = (uint8_t*)malloc(PQC_RESP_BYTES);
+            if (!buf) {
+                break;
+            }
+            pqc_resp_nfree++;
+            pqc_reserved_bytes += PQC_RESP_BYTES;
+        }
+        if (!esk2.buf || !esk3.buf || !esk5.buf || workers == 0 || pqc_resp_nfree < PQC_RESP_BUFS) {
+            ESP_LOGE(TAG, "Failed to allocate expanded keys.");
+            return;
+        }
         ESP_LOGI(TAG, "Keypairs ready.");
 
-        xTaskCreate(tcp_server_task, "tcp_server", 36864, NULL, 5, NULL);
+        UBaseType_t boot_stack_left = uxTaskGetStackHighWaterMark(NULL);
+        if (boot_stack_left < PQC_BOOT_STACK_MARGIN) {
+            ESP_LOGW(TAG, "Main task stack nearly exhausted: %u bytes left.", (unsigned)boot_stack_left);
+        } else {
+            ESP_LOGI(TAG, "Main task stack: %u bytes left.", (unsigned)boot_stack_left);
+        }
+
+        // Only the tiers that spread their signing get the helper
+        pqc_dual_core_ready = pqc_parallel_init(PQC_HELPER_CORE);
+        for (const pqc_tier_t &t : pqc_tiers) {
+            t.set_parallel(t.spread && pqc_dual_core_ready ? pqc_par_for : NULL);
+        }
+
+        pqc_sign_lock = xSemaphoreCreateMutex();
+        if (!pqc_sign_lock) {
+            ESP_LOGE(TAG, "Failed to create signing lock.");
+            return;
+        }
+        if (PQC_PRESIGN_DEPTH > 0 && PQC_SIGN_RND != PQC_RND_DETERMINISTIC) {
+            pqc_presign_init();
+        }
+
+        // One slot per connection in each queue, so neither side waits
+        esp_vfs_eventfd_config_t eventfd_config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+        pqc_job_queue = xQueueCreate(PQC_MAX_CONNS, sizeof(pqc_conn_t*));
+        pqc_done_queue = xQueueCreate(PQC_MAX_CONNS, sizeof(pqc_conn_t*));
+        if (!pqc_job_queue || !pqc_done_queue || esp_vfs_eventfd_register(&eventfd_config) != ESP_OK
+            || (pqc_wake_fd = eventfd(0, 0)) < 0) {
+            ESP_LOGE(TAG, "Failed to create the request queues.");
+            return;
+        }
+        for (int i = 0; i < workers; i++) {
+            char name[16];
+            snprintf(name, sizeof(name), "pqc_worker%d", i);
+            xTaskCreatePinnedToCore(pqc_worker_task, name, PQC_WORKER_STACK, &pqc_workers[i],
+                                    PQC_WORKER_PRIO, NULL, i % portNUM_PROCESSORS);
+        }
+        ESP_LOGI(TAG, "%d signing workers across both cores.", workers);
+
+        xTaskCreatePinnedToCore(tcp_server_task, "tcp_server", PQC_LOOP_STACK, NULL, PQC_LOOP_PRIO, NULL,
+                                PQC_SERVER_CORE);
     } else {
         ESP_LOGE(TAG, "Wi-Fi connection failed.");
     }
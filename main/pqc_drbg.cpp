@@ -0,0 +1,99 @@
+#include "pqc_drbg.h"
+
+#include <string.h>
+
+#include "esp_random.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+extern "C" {
+#include "fips202.h"
+}
+
+// Calls between two reseeds from the hardware RNG
+#define PQC_DRBG_RESEED_INTERVAL 256
+#define PQC_DRBG_KEYBYTES 32
+
+// SHAKE256 keyed by a 32-byte secret. Every output step replaces the key
+// with fresh SHAKE output, so earlier outputs cannot be recomputed from
+// the state; a reseed hashes new entropy into the key.
+struct pqc_drbg_t {
+    uint8_t key[PQC_DRBG_KEYBYTES];
+    unsigned int calls;
+};
+
+static pqc_drbg_t s_drbg;
+// Signing workers draw from the DRBG concurrently
+static SemaphoreHandle_t s_drbg_lock;
+
+static void drbg_reseed(pqc_drbg_t *d, const uint8_t *entropy, size_t len) {
+    shake256incctx state;
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, d->key, PQC_DRBG_KEYBYTES);
+    shake256_inc_absorb(&state, entropy, len);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(d->key, PQC_DRBG_KEYBYTES, &state);
+    shake256_inc_ctx_release(&state);
+    d->calls = 0;
+}
+
+static void drbg_generate(pqc_drbg_t *d, uint8_t *out, size_t len) {
+    shake256incctx state;
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, d->key, PQC_DRBG_KEYBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(d->key, PQC_DRBG_KEYBYTES, &state);
+    shake256_inc_squeeze(out, len, &state);
+    shake256_inc_ctx_release(&state);
+    d->calls++;
+}
+
+static void drbg_reseed_hw(pqc_drbg_t *d) {
+    uint8_t entropy[PQC_DRBG_KEYBYTES];
+    esp_fill_random(entropy, sizeof(entropy));
+    drbg_reseed(d, entropy, sizeof(entropy));
+    memset(entropy, 0, sizeof(entropy));
+}
+
+void pqc_drbg_init(void) {
+    s_drbg_lock = xSemaphoreCreateMutex();
+    memset(&s_drbg, 0, sizeof(s_drbg));
+    drbg_reseed_hw(&s_drbg);
+}
+
+void pqc_drbg_fill(uint8_t *out, size_t len) {
+    xSemaphoreTake(s_drbg_lock, portMAX_DELAY);
+    if (s_drbg.calls >= PQC_DRBG_RESEED_INTERVAL) {
+        drbg_reseed_hw(&s_drbg);
+    }
+    drbg_generate(&s_drbg, out, len);
+    xSemaphoreGive(s_drbg_lock);
+}
+
+int pqc_drbg_kat(void) {
+    // Seed 00..1f, two outputs of 32 bytes, reseed with 20..3f, one more
+    static const uint8_t expected[3][8] = {
+        {0x29, 0x74, 0xb3, 0x61, 0x0c, 0xe6, 0xef, 0x15},
+        {0x3a, 0x55, 0xa8, 0xff, 0xec, 0xbe, 0xca, 0xf2},
+        {0x23, 0x49, 0x42, 0x82, 0x64, 0x2a, 0x07, 0x3e},
+    };
+    pqc_drbg_t d = {};
+    uint8_t buf[PQC_DRBG_KEYBYTES];
+    int ret = 0;
+
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)i;
+    }
+    drbg_reseed(&d, buf, sizeof(buf));
+    for (int j = 0; j < 3; j++) {
+        if (j == 2) {
+            for (size_t i = 0; i < sizeof(buf); i++) {
+                buf[i] = (uint8_t)(0x20 + i);
+            }
+            drbg_reseed(&d, buf, sizeof(buf));
+        }
+        drbg_generate(&d, buf, sizeof(buf));
+        ret |= memcmp(buf, expected[j], sizeof(expected[j]));
+    }
+    return ret ? -1 : 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Seeds the signing DRBG from the hardware RNG.
+ *
+ * Must be called once before pqc_drbg_fill is registered with a signer.
+ */
+void pqc_drbg_init(void);
+
+/**
+ * @brief Writes len bytes of DRBG output; reseeds from the hardware RNG
+ *        every PQC_DRBG_RESEED_INTERVAL calls.
+ *
+ * Matches the hook expected by crypto_sign_set_rnd. Safe to call from
+ * several signing workers at once.
+ */
+void pqc_drbg_fill(uint8_t *out, size_t len);
+
+/**
+ * @brief Known-answer self-test of the DRBG on a private instance.
+ *
+ * @return 0 on success
+ */
+int pqc_drbg_kat(void);
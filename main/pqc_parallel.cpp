@@ -0,0 +1,96 @@
+#include "pqc_parallel.h"
+
+#include <atomic>
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#define TAG "PQC_PAR"
+
+// Stack for the helper. Its deepest path is a whole speculative attempt
+// (sign_spec_attempt): 4-way mask sampling, a row of A streamed through the
+// 4-way matrix sampler and the response, about 6 KB at its deepest; the
+// rest is headroom. The fork-join bodies of a spread attempt stay under
+// 1.5 KB. Each new low of the unused part is logged, with a warning under
+// PQC_HELPER_STACK_MARGIN.
+#define PQC_HELPER_STACK        8192
+#define PQC_HELPER_STACK_MARGIN 2048
+
+// --- Current job, owned by whoever holds s_lock ---
+static void (*s_body)(void *arg, unsigned int i);
+static void *s_arg;
+static unsigned int s_n;
+static std::atomic<unsigned int> s_next;
+
+static SemaphoreHandle_t s_lock;   // one job at a time
+static SemaphoreHandle_t s_start;  // caller -> helper
+static SemaphoreHandle_t s_done;   // helper -> caller
+
+/**
+ * @brief Claims indices until none are left. Run by both sides.
+ */
+static void run_job(void) {
+    unsigned int i;
+    while ((i = s_next.fetch_add(1)) < s_n) {
+        s_body(s_arg, i);
+    }
+}
+
+static void helper_task(void *pvParams) {
+    UBaseType_t stack_low = PQC_HELPER_STACK;
+    while (1) {
+        xSemaphoreTake(s_start, portMAX_DELAY);
+        run_job();
+        xSemaphoreGive(s_done);
+
+        UBaseType_t stack_left = uxTaskGetStackHighWaterMark(NULL);
+        if (stack_left < stack_low) {
+            stack_low = stack_left;
+            if (stack_left < PQC_HELPER_STACK_MARGIN) {
+                ESP_LOGW(TAG, "Helper stack nearly exhausted: %u bytes left.",
+                         (unsigned)stack_left);
+            } else {
+                ESP_LOGI(TAG, "Helper stack: %u bytes left.", (unsigned)stack_left);
+            }
+        }
+    }
+}
+
+bool pqc_parallel_init(int core) {
+    s_lock = xSemaphoreCreateMutex();
+    s_start = xSemaphoreCreateBinary();
+    s_done = xSemaphoreCreateBinary();
+    if (!s_lock || !s_start || !s_done) {
+        ESP_LOGE(TAG, "Failed to create semaphores.");
+        return false;
+    }
+    if (xTaskCreatePinnedToCore(helper_task, "pqc_helper", PQC_HELPER_STACK,
+                                NULL, 5, NULL, core) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to start helper task.");
+        return false;
+    }
+    ESP_LOGI(TAG, "Signing helper running on core %d.", core);
+    return true;
+}
+
+void pqc_par_for(void (*body)(void *arg, unsigned int i), void *arg, unsigned int n) {
+    if (n < 2 || !s_lock || xSemaphoreTake(s_lock, 0) != pdTRUE) {
+        for (unsigned int i = 0; i < n; ++i) {
+            body(arg, i);
+        }
+        return;
+    }
+
+    s_body = body;
+    s_arg = arg;
+    s_n = n;
+    s_next.store(0);
+
+    xSemaphoreGive(s_start);
+    run_job();
+    xSemaphoreTake(s_done, portMAX_DELAY);
+
+    xSemaphoreGive(s_lock);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdbool.h>
+
+/**
+ * @brief Starts the signing helper task pinned to the given core.
+ *
+ * Must be called once before pqc_par_for is registered with a signer.
+ */
+bool pqc_parallel_init(int core);
+
+/**
+ * @brief Fork-join over [0, n) shared between the caller and the helper.
+ *
+ * Matches the hook expected by crypto_sign_set_parallel. Falls back to
+ * running everything on the caller when the helper is busy with another
+ * request or was never started.
+ */
+void pqc_par_for(void (*body)(void *arg, unsigned int i), void *arg, unsigned int n);
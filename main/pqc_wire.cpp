@@ -0,0 +1,31 @@
+#include "pqc_wire.h"
+
+static void store_be16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+static void store_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+uint32_t pqc_wire_load32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+void pqc_wire_header(uint8_t *out, uint8_t alg_id, uint32_t sign_time_us,
+                     size_t siglen, size_t keyidlen, size_t pklen) {
+    uint8_t flags = (pklen ? PQC_WIRE_F_PUBLIC_KEY : 0) | (keyidlen ? PQC_WIRE_F_KEY_ID : 0);
+
+    store_be32(out, (uint32_t)(PQC_WIRE_HDRBYTES - 4 + siglen + keyidlen + pklen));
+    out[4] = PQC_WIRE_VERSION;
+    out[5] = alg_id;
+    out[6] = flags;
+    out[7] = (uint8_t)keyidlen;
+    store_be32(out + 8, sign_time_us);
+    store_be16(out + 12, (uint16_t)siglen);
+    store_be16(out + 14, (uint16_t)pklen);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Binary response frame, all integers big-endian:
+//
+//   u32  length of everything after this field
+//   u8   PQC_WIRE_VERSION
+//   u8   algorithm ID (the ML-DSA parameter set: 44, 65 or 87)
+//   u8   flags (PQC_WIRE_F_*)
+//   u8   key ID length, 0 without PQC_WIRE_F_KEY_ID
+//   u32  signing time in microseconds
+//   u16  signature length
+//   u16  public key length, 0 without PQC_WIRE_F_PUBLIC_KEY
+//   signature | key ID | public key
+//
+// The header carries every length, so a reader needs no delimiters and
+// the signature and key go out as they are, without hex encoding.
+#define PQC_WIRE_VERSION 1
+#define PQC_WIRE_HDRBYTES 16
+
+#define PQC_WIRE_F_PUBLIC_KEY 0x01
+#define PQC_WIRE_F_KEY_ID     0x02
+
+// A key ID is the SHA3-256 fingerprint of the public key. Signature
+// responses carry it instead of the key, which a client fetches once and
+// caches.
+#define PQC_WIRE_KEYIDBYTES 32
+
+// Requests open with a type byte:
+//   PQC_REQ_SIGN         the message follows, up to the end of the stream;
+//                        the connection closes after the response
+//   PQC_REQ_GET_KEY      a key ID follows; the response carries that key
+//                        ID and the public key without a signature, or is
+//                        an empty frame with algorithm ID 0 for an unknown
+//                        key
+//   PQC_REQ_SIGN_FRAMED  a u32 message length and the message follow
+// After the last two the connection stays open for the next request, so a
+// client can pipeline them; responses come back in request order.
+#define PQC_REQ_SIGN        0x01
+#define PQC_REQ_GET_KEY     0x02
+#define PQC_REQ_SIGN_FRAMED 0x03
+
+/**
+ * @brief Writes the PQC_WIRE_HDRBYTES header of a response frame.
+ *
+ * The body that follows is siglen bytes of signature, then keyidlen bytes
+ * of key ID and pklen bytes of public key; either length may be 0, which
+ * clears its flag.
+ */
+void pqc_wire_header(uint8_t *out, uint8_t alg_id, uint32_t sign_time_us,
+                     size_t siglen, size_t keyidlen, size_t pklen);
+
+/**
+ * @brief Reads a big-endian u32, such as a framed request's length.
+ */
+uint32_t pqc_wire_load32(const uint8_t *p);
@@ -8,6 +8,15 @@
 
 #define TAG "TFLITE"
 constexpr int kTensorArenaSize = 20 * 1024;
+// Classes predict() chooses from: 0 = Dilithium2, 1 = Dilithium3, 2 = Dilithium5
+constexpr int kPqcTiers = 3;
+// Stopgap until a model is trained on Dilithium3 runs: the shipped model
+// has a single sigmoid output (Dilithium2 vs Dilithium5, see
+// machine-learning/preprocessing.py), which is split into bands at these
+// scores, the uncertain middle going to Dilithium3. The bands are not
+// learned. A model with one softmax score per tier is used as it is.
+constexpr float kTierLow = 0.35f;
+constexpr float kTierHigh = 0.65f;
 static uint8_t tensor_arena[kTensorArenaSize];
 
 class TFLiteRunner {
@@ -48,9 +57,23 @@ public:
             return 0;  // default to Dilithium2
         }
 
+        static const int levels[kPqcTiers] = {2, 3, 5};
+        int decision = 0;
         float val = output->data.f[0];
-        int decision = (val > 0.5f) ? 1 : 0; // 1 = Dilithium5, 0 = Dilithium2
-        ESP_LOGI(TAG, "ML predicted: %.2f → Using Dilithium%d", val, decision ? 5 : 2);
+        if (output->dims->data[output->dims->size - 1] >= kPqcTiers) {
+            // One score per tier (softmax head): take the highest
+            for (int i = 1; i < kPqcTiers; i++) {
+                if (output->data.f[i] > output->data.f[decision]) {
+                    decision = i;
+                }
+            }
+            val = output->data.f[decision];
+        } else if (val > kTierHigh) {
+            decision = 2;
+        } else if (val > kTierLow) {
+            decision = 1;
+        }
+        ESP_LOGI(TAG, "ML predicted: %.2f → Using Dilithium%d", val, levels[decision]);
         return decision;
     }
 